@@ -15,6 +15,16 @@
 #define LINE_WIDTH      (DISPLAY_WIDTH / 8u)           /* 18 bytes */
 #define BUFFER_LENGTH   (DISPLAY_HEIGHT * LINE_WIDTH)  /* 3024 bytes */
 
+/* Frame buffers handed to the flush functions are in panel stream layout:
+ *   [WRITE_CMD] { [GATE_ADDR] [LINE_DATA x LINE_WIDTH] [DUMMY] } x H [DUMMY]
+ * Any run of consecutive lines is then one contiguous span on the wire, so
+ * flushes transmit straight out of the buffer. LCD_StreamInit() writes the
+ * framing bytes; callers only ever touch the line data. Rows are 1-based. */
+#define LCD_STREAM_LINE_STRIDE      (LINE_WIDTH + 2u)                                 /* 20 bytes */
+#define LCD_STREAM_LENGTH           (1u + (DISPLAY_HEIGHT * LCD_STREAM_LINE_STRIDE) + 1u) /* 3362 bytes */
+#define LCD_STREAM_LINE_OFFSET(row) (1u + (((uint32_t)(row) - 1u) * LCD_STREAM_LINE_STRIDE))
+#define LCD_STREAM_DATA_OFFSET(row) (LCD_STREAM_LINE_OFFSET(row) + 1u)
+
 typedef struct {
     SPI_HandleTypeDef *Bus;
     GPIO_TypeDef      *dispGPIO;
@@ -29,6 +39,9 @@ HAL_StatusTypeDef LCD_Init(LS013B7DH05 *MemDisp,
 
 HAL_StatusTypeDef LCD_Clean(LS013B7DH05 *MemDisp);
 
+/* Write the command, gate address and dummy bytes of a stream buffer. */
+void LCD_StreamInit(uint8_t *stream);
+
 /* Blocking flush */
 HAL_StatusTypeDef LCD_FlushAll(LS013B7DH05 *MemDisp, const uint8_t *buf);
 HAL_StatusTypeDef LCD_FlushRows(LS013B7DH05 *MemDisp, const uint8_t *buf,
@@ -39,6 +52,24 @@ HAL_StatusTypeDef LCD_FlushAll_DMA(LS013B7DH05 *MemDisp, const uint8_t *buf);
 HAL_StatusTypeDef LCD_FlushRows_DMA(LS013B7DH05 *MemDisp, const uint8_t *buf,
                                     const uint16_t *rows, uint16_t rowCount);
 
+/* Staged DMA flush: build the DMA descriptors for the idle slot while a
+ * previous transfer may still be running, then start it once that transfer
+ * is done. `buf` is read in place and must stay untouched until completion;
+ * rows must be ascending. */
+HAL_StatusTypeDef LCD_StageAll_DMA(LS013B7DH05 *MemDisp, const uint8_t *buf);
+HAL_StatusTypeDef LCD_StageRows_DMA(LS013B7DH05 *MemDisp, const uint8_t *buf,
+                                    const uint16_t *rows, uint16_t rowCount);
+HAL_StatusTypeDef LCD_StartStaged_DMA(LS013B7DH05 *MemDisp);
+
+/* Streaming DMA flush: rows go on the wire as soon as they are handed over,
+ * so the caller can pack the rest of the frame while earlier rows transmit.
+ * Begin claims the (idle) bus, Rows appends lines of `buf` that are final,
+ * End adds the closing dummy; completion is reported like any DMA flush.
+ * Rows must ascend across the whole stream. */
+HAL_StatusTypeDef LCD_StreamBegin_DMA(LS013B7DH05 *MemDisp, const uint8_t *buf);
+HAL_StatusTypeDef LCD_StreamRows_DMA(LS013B7DH05 *MemDisp, const uint16_t *rows, uint16_t rowCount);
+HAL_StatusTypeDef LCD_StreamEnd_DMA(LS013B7DH05 *MemDisp);
+
 bool              LCD_FlushDMA_IsDone(void);
 HAL_StatusTypeDef LCD_FlushDMA_WaitWFI(uint32_t timeout_ms);
 
@@ -0,0 +1,76 @@
+#ifndef AUDIO_ADPCM_H
+#define AUDIO_ADPCM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * IMA-ADPCM block decoders for the audio mixer.
+ *
+ * Both decode a run of samples per call instead of one sample at a time:
+ * audio_adpcm_decode() reads a WAV image in memory, and
+ * audio_adpcm_stream_decode() pulls block bytes from the storage stream ring
+ * (storage_stream_available/read). Either may be called with any count and
+ * picks up mid-byte where the previous call stopped.
+ */
+typedef enum
+{
+  WAV_FORMAT_PCM = 1U,
+  WAV_FORMAT_IMA_ADPCM = 0x11U
+} wav_format_t;
+
+typedef struct
+{
+  const uint8_t *data;
+  uint32_t data_bytes;
+  uint32_t sample_rate;
+  wav_format_t format;
+  uint32_t total_frames;
+  uint16_t channels;
+  uint16_t bits_per_sample;
+  uint16_t block_align;
+  uint16_t samples_per_block;
+} wav_info_t;
+
+typedef struct
+{
+  uint32_t data_offset;
+  uint32_t block_end;
+  uint32_t byte_offset;
+  uint16_t samples_left;
+  int16_t predictor;
+  uint8_t index;
+  uint8_t nibble_high;
+} adpcm_state_t;
+
+typedef struct
+{
+  uint16_t samples_left;
+  uint16_t block_bytes_left;
+  int16_t predictor;
+  uint8_t index;
+  uint8_t nibble_high;
+  uint8_t cur_byte;
+} adpcm_stream_state_t;
+
+void audio_adpcm_reset(adpcm_state_t *state);
+/* Returns the samples written; fewer than `count` means the data ran out. */
+uint32_t audio_adpcm_decode(const wav_info_t *wav, adpcm_state_t *state, int16_t *dst, uint32_t count);
+
+void audio_adpcm_stream_reset(adpcm_stream_state_t *state);
+/*
+ * `bytes_left` counts the stream bytes not yet taken as blocks and is
+ * decremented per block. Returns the samples written; a short count is an
+ * underrun unless `done` is set, in which case the stream has ended.
+ */
+uint32_t audio_adpcm_stream_decode(adpcm_stream_state_t *state, const wav_info_t *wav, uint32_t *bytes_left,
+                                   int16_t *dst, uint32_t count, uint8_t *done);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AUDIO_ADPCM_H */
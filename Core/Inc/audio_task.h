@@ -9,12 +9,28 @@
 extern "C" {
 #endif
 
+/* sound_play() to first audible DMA half, in ms; see audio_latency_mark_enqueue(). */
+typedef struct
+{
+  uint32_t last_ms;        /* Latency of the last measured sound */
+  uint32_t max_ms;         /* Worst latency since boot */
+  uint32_t count;          /* Sounds measured since boot */
+  uint16_t period_frames;  /* Half-buffer size the output last started with */
+} audio_latency_stats_t;
+
 void audio_task_run(void);
 void audio_set_volume(uint8_t level);
 uint8_t audio_get_volume(void);
 uint8_t audio_is_active(void);
 void audio_set_category_volume(sound_category_t category, uint8_t level);
 uint8_t audio_get_category_volume(sound_category_t category);
+/*
+ * Timestamp a play request and return the tag for its command's
+ * SOUND_CMD_LAT field; called by sound_play_ex(). Only the source that
+ * command starts is timed, so a request that is dropped leaves no state.
+ */
+uint8_t audio_latency_mark_enqueue(void);
+void audio_get_latency_stats(audio_latency_stats_t *out);
 
 #ifdef __cplusplus
 }
@@ -11,10 +11,13 @@ extern "C" {
 void debug_uart_printf(const char *fmt, ...);
 void debug_uart_log(const char *msg);
 void debug_uart_tx_done(void);
+/* Block (osDelay polling) until the last message has left, or timeout_ms elapses. */
+void debug_uart_wait_idle(uint32_t timeout_ms);
 #else
 #define debug_uart_printf(...) ((void)0)
 #define debug_uart_log(...) ((void)0)
 #define debug_uart_tx_done() ((void)0)
+#define debug_uart_wait_idle(...) ((void)0)
 #endif
 
 #ifdef __cplusplus
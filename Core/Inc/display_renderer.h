@@ -18,13 +18,27 @@ typedef enum
   RENDER_LAYER_BG = 2
 } render_layer_t;
 
+/*
+ * Dither states are opaque ordered-dither grays: RENDER_STATE_DITHER(n)
+ * paints n of every 16 pixels BLACK and the rest WHITE, in a 4x4 Bayer
+ * pattern anchored to the panel, so adjacent shapes of one gray line up.
+ * They work with every primitive at the cost of a solid color.
+ */
 typedef enum
 {
   RENDER_STATE_TRANSPARENT = 0,
   RENDER_STATE_BLACK = 1,
-  RENDER_STATE_WHITE = 2
+  RENDER_STATE_WHITE = 2,
+  RENDER_STATE_DITHER_FIRST = 3,   /* level 1 */
+  RENDER_STATE_GRAY_25 = 6,        /* level 4 */
+  RENDER_STATE_GRAY_50 = 10,       /* level 8 */
+  RENDER_STATE_GRAY_75 = 14,       /* level 12 */
+  RENDER_STATE_DITHER_LAST = 17    /* level 15 */
 } render_state_t;
 
+/* Dither level 1..15 as a state; see renderDitherState() for the full 0..16 range. */
+#define RENDER_STATE_DITHER(level) ((render_state_t)((uint32_t)RENDER_STATE_DITHER_FIRST + (uint32_t)(level) - 1U))
+
 typedef enum
 {
   RENDER_ROTATION_0 = 0,
@@ -33,11 +47,68 @@ typedef enum
   RENDER_ROTATION_270_CW = 3
 } render_rotation_t;
 
+/*
+ * How a 1bpp source paints the destination layer:
+ *   TRANSPARENT : set bits draw `fg`, clear bits leave the layer untouched
+ *   OPAQUE      : set bits draw `fg`, clear bits draw the opposite color
+ *   INVERTED    : clear bits draw `fg`, set bits leave the layer untouched
+ */
+typedef enum
+{
+  RENDER_BLIT_TRANSPARENT = 0,
+  RENDER_BLIT_OPAQUE = 1,
+  RENDER_BLIT_INVERTED = 2
+} render_blit_mode_t;
+
+typedef struct
+{
+  int16_t x;
+  int16_t y;
+} render_point_t;
+
+typedef struct
+{
+  int16_t x;
+  int16_t y;
+  uint16_t width;
+  uint16_t height;
+} render_rect_t;
+
+#define RENDER_POLYGON_MAX_POINTS 16U
+/* Dither levels run from 0 (all WHITE) to RENDER_DITHER_LEVELS (all BLACK). */
+#define RENDER_DITHER_LEVELS 16U
+
 void renderInit(void);
+/* State for `level` BLACK pixels of every 16 (0 = WHITE, RENDER_DITHER_LEVELS and above = BLACK). */
+render_state_t renderDitherState(uint8_t level);
+/*
+ * Packed buffer filled by the last renderTakeDirtyRows() that returned rows,
+ * in LCD stream layout (LCD_STREAM_LENGTH bytes; line data of row r starts at
+ * LCD_STREAM_DATA_OFFSET(r)). Only the rows it returned are guaranteed
+ * current; the buffer stays stable until the next such call, which packs into
+ * the other buffer of the pair.
+ */
 const uint8_t *renderGetBuffer(void);
 bool renderTakeDirtyRows(uint16_t *rows, uint16_t max_rows, uint16_t *out_count, bool *out_full);
+/*
+ * renderTakeDirtyRows() in steps, for flushes that transmit while packing.
+ * Begin returns the buffer rows will be packed into (NULL if nothing is
+ * dirty); each Pack call packs up to `max_rows` more rows in ascending order
+ * and returns how many it appended (0 once the pass is done); End makes the
+ * buffer the one renderGetBuffer() returns if the pass produced any rows.
+ * Rows returned by Pack are final in the buffer as soon as it returns.
+ */
+const uint8_t *renderBeginDirtyRows(void);
+uint16_t renderPackDirtyRows(uint16_t *rows, uint16_t max_rows);
+void renderEndDirtyRows(void);
 void renderMarkDirtyRows(uint16_t start_row, uint16_t end_row);
 void renderMarkDirtyList(const uint16_t *rows, uint16_t row_count);
+/*
+ * When enabled (the default), renderTakeDirtyRows() drops rows whose packed
+ * line matches the checksum of the line it last returned for that row. Rows
+ * marked with renderMarkDirtyRows/List are always returned.
+ */
+void renderSetFrameDiff(bool enable);
 
 void renderSetRotation(render_rotation_t rotation);
 render_rotation_t renderGetRotation(void);
@@ -45,6 +116,8 @@ uint16_t renderGetWidth(void);
 uint16_t renderGetHeight(void);
 
 void renderFill(bool fill);
+/* Make UI or GAME fully transparent, or fill BG white, leaving the other layers as they are. */
+void renderClearLayer(render_layer_t layer);
 void renderInvert(void);
 void renderFillRows(uint16_t start_row, uint16_t end_row, bool fill);
 void renderInvertRows(uint16_t start_row, uint16_t end_row);
@@ -66,8 +139,39 @@ void renderBlit1bpp(uint16_t x, uint16_t y, uint16_t width, uint16_t height, con
                     uint16_t stride_bytes, render_layer_t layer, render_state_t fg);
 void renderBlit1bppMsb(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *data,
                        uint16_t stride_bytes, render_layer_t layer, render_state_t fg);
+/* Blit a window of a larger bitmap starting at source column `src_x`; x/y may be off-screen. */
+void renderBlit1bppEx(int16_t x, int16_t y, uint16_t width, uint16_t height, const uint8_t *data,
+                      uint16_t stride_bytes, uint16_t src_x, render_layer_t layer, render_state_t fg,
+                      render_blit_mode_t mode);
+void renderBlit1bppMsbEx(int16_t x, int16_t y, uint16_t width, uint16_t height, const uint8_t *data,
+                         uint16_t stride_bytes, uint16_t src_x, render_layer_t layer, render_state_t fg,
+                         render_blit_mode_t mode);
+/*
+ * Filled triangles and convex polygons (up to RENDER_POLYGON_MAX_POINTS, in
+ * either winding). Coordinates may be off-screen; `clip`, if not NULL,
+ * restricts the fill to a logical rectangle. Pixels whose centers lie inside
+ * are filled, excluding the right and bottom edges, so polygons that share an
+ * edge tile without overlap.
+ */
+void renderFillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2,
+                        render_layer_t layer, render_state_t state);
+void renderFillPolygon(const render_point_t *points, uint8_t count, const render_rect_t *clip,
+                       render_layer_t layer, render_state_t state);
+/* Fill with renderDitherState(level). */
+void renderFillPolygonDither(const render_point_t *points, uint8_t count, const render_rect_t *clip,
+                             render_layer_t layer, uint8_t level);
+/*
+ * Move the content of one layer inside a logical rectangle (NULL = whole
+ * screen) by (dx, dy) pixels; pixels outside it are untouched. The strips the
+ * content leaves behind hold stale data until the caller redraws them.
+ */
+void renderScrollLayer(const render_rect_t *rect, int16_t dx, int16_t dy, render_layer_t layer);
 void renderDrawCharScaled(uint16_t x, uint16_t y, char ch, uint8_t scale, render_layer_t layer, render_state_t fg);
 void renderDrawTextScaled(uint16_t x, uint16_t y, const char *text, uint8_t scale, render_layer_t layer, render_state_t fg);
+/* Pixel extent of `text` as drawn by renderDrawText(Scaled), without wrapping; '\n' starts a new line. */
+void renderMeasureText(const char *text, uint8_t scale, uint16_t *out_width, uint16_t *out_height);
+/* Width in pixels of the widest line of unscaled text (0 for NULL or empty). */
+uint16_t renderTextWidth(const char *text);
 
 
 
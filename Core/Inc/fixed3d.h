@@ -0,0 +1,85 @@
+#ifndef FIXED3D_H
+#define FIXED3D_H
+
+#include "display_renderer.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Q16.16 fixed-point 3D math for render modules: no FPU work per frame.
+ *
+ * Angles are binary: a full turn is 65536, so they wrap for free in a
+ * uint16_t. Sine/cosine come from a quarter-wave table with linear
+ * interpolation (error below 2^-14).
+ */
+typedef int32_t  q16_t;
+typedef uint16_t fx3d_angle_t;
+
+#define Q16_ONE               (65536L)
+/* Compile-time constant from a float literal, e.g. for model tables. */
+#define Q16_C(f)              ((q16_t)(((f) >= 0.0) ? (((f) * 65536.0) + 0.5) : (((f) * 65536.0) - 0.5)))
+#define FX3D_ANGLE_TURN       (65536UL)
+/* Compile-time angle from radians. */
+#define FX3D_ANGLE_RAD(r)     ((fx3d_angle_t)((uint32_t)(((r) * 10430.378350470453) + 0.5) & 0xFFFFU))
+
+typedef struct
+{
+  q16_t x;
+  q16_t y;
+  q16_t z;
+} fx3d_vec3_t;
+
+/* Row-major: out = m * v. */
+typedef struct
+{
+  q16_t m[3][3];
+} fx3d_mat3_t;
+
+/*
+ * Pinhole camera: the model is pushed `z_offset` away from the camera,
+ * depths are clamped to `near_z`, and `focal` is in pixels. Projected x/y
+ * must stay within int16 range; |focal * x| below 2^31 / Q16_ONE.
+ */
+typedef struct
+{
+  q16_t   z_offset;
+  q16_t   near_z;
+  int32_t focal;
+  int16_t cx;
+  int16_t cy;
+} fx3d_camera_t;
+
+static inline q16_t q16_mul(q16_t a, q16_t b)
+{
+  return (q16_t)(((int64_t)a * b) >> 16);
+}
+
+/* Round to the nearest integer, halves away from zero. */
+static inline int32_t q16_round(q16_t a)
+{
+  return (a >= 0) ? ((a + 0x8000L) >> 16) : -((-a + 0x8000L) >> 16);
+}
+
+q16_t fx3d_sin(fx3d_angle_t a);
+q16_t fx3d_cos(fx3d_angle_t a);
+
+q16_t fx3d_dot(const fx3d_vec3_t *a, const fx3d_vec3_t *b);
+void fx3d_mat3_identity(fx3d_mat3_t *m);
+/* Rotation about Y by `ay`, then about X by `ax`. */
+void fx3d_mat3_rot_yx(fx3d_mat3_t *m, fx3d_angle_t ay, fx3d_angle_t ax);
+void fx3d_mat3_mul(const fx3d_mat3_t *a, const fx3d_mat3_t *b, fx3d_mat3_t *out);
+void fx3d_transform(const fx3d_mat3_t *m, const fx3d_vec3_t *v, fx3d_vec3_t *out);
+/* Batched fx3d_transform(); `in` and `out` may be the same array. */
+void fx3d_transform_points(const fx3d_mat3_t *m, const fx3d_vec3_t *in, fx3d_vec3_t *out, uint32_t count);
+/* Perspective project `count` camera-space points to screen coordinates. */
+void fx3d_project_points(const fx3d_camera_t *cam, const fx3d_vec3_t *in, render_point_t *out, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FIXED3D_H */
@@ -1,11 +1,35 @@
 #ifndef GAME_TASK_H
 #define GAME_TASK_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#define GAME_TICK_HZ (30U)  /* Fixed simulation rate */
+
+/* Frame pacing counters for the performance HUD; times are of the last frame. */
+typedef struct
+{
+  uint32_t period_ms;   /* Target frame period for the current perf mode */
+  uint32_t frame_ms;    /* Interval between the last two frame submissions */
+  uint32_t render_us;   /* Scene draw time in tskDisplay */
+  uint32_t flush_us;    /* Pack and transfer hand-off time in tskDisplay */
+  uint32_t frames;      /* Frames presented since the loop started */
+  uint32_t dropped;     /* Frame slots missed since the loop started */
+  uint32_t ticks;       /* Simulation ticks run since the loop started */
+} game_frame_stats_t;
+
 void game_task_run(void);
+void game_task_get_frame_stats(game_frame_stats_t *out);
+/* Called by tskDisplay once a submitted frame has been handed to the panel. */
+void game_task_frame_presented(uint32_t render_us, uint32_t flush_us);
+/*
+ * Wake tskGame from its idle wait so it starts pacing the demo. Call after
+ * setting RENDER_DEMO_MODE_RUN in game mode, or when a paused demo may resume.
+ */
+void game_task_wake(void);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,44 @@
+#ifndef RENDER_BENCH_H
+#define RENDER_BENCH_H
+
+#include <stdint.h>
+
+/*
+ * Renderer benchmark. The cases (render_bench.c) are plain renderer calls;
+ * two runners time them:
+ *  - Host/render_bench_host.c: host build with HAL/RTOS stubs, the one to
+ *    track regressions with (see Host/CMakeLists.txt)
+ *  - render_bench_target.c: build with RENDER_BENCH=1 to have the display
+ *    task time them once at boot with the DWT cycle counter and log the
+ *    results over debug_uart (needs DEBUGGING)
+ */
+#ifndef RENDER_BENCH
+#define RENDER_BENCH 0
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* One timed operation; returns the number of pixels (or vertices) it covered. */
+typedef uint32_t (*render_bench_fn_t)(uint32_t iter, uint16_t width, uint16_t height);
+
+typedef struct
+{
+  const char        *name;
+  uint32_t           iterations;
+  render_bench_fn_t  fn;
+} render_bench_case_t;
+
+const render_bench_case_t *render_bench_cases(uint32_t *count);
+/* Prepare the case inputs before the first case; restore the renderer after the last. */
+void render_bench_begin(void);
+void render_bench_end(void);
+
+void render_bench_run(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RENDER_BENCH_H */
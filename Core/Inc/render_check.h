@@ -0,0 +1,71 @@
+#ifndef RENDER_CHECK_H
+#define RENDER_CHECK_H
+
+#include "ui_pages.h"
+
+#include <stdint.h>
+
+/*
+ * Golden-frame check: a fixed set of scenarios (every UI page, the sleep
+ * face and the first demo frames), each rendered from a clean renderer and
+ * packed as the panel would receive it.
+ *
+ * render_check.c holds the scenarios and the frame helpers and builds on
+ * the target and on the host. Host/render_check_host.c compares each frame
+ * bit for bit with a checked-in PBM in Host/golden/ and is part of ctest.
+ *
+ * Build with RENDER_CHECK=1 to have the display task run the same scenarios
+ * once at boot (render_check_target.c), compare each frame's CRC against
+ * the golden CRC in the scenario table and log the result and render time
+ * over debug_uart (needs DEBUGGING).
+ *
+ * With RENDER_CHECK_DUMP=1 every frame that does not match is also logged
+ * as a PBM: a "pbm <name> <w> <h>" line followed by one "pbm <hex>" line
+ * per row. On the host, the hex of those rows through `xxd -r -p` behind a
+ * "P4\n<w> <h>\n" header is the image.
+ */
+#ifndef RENDER_CHECK
+#define RENDER_CHECK 0
+#endif
+
+#ifndef RENDER_CHECK_DUMP
+#define RENDER_CHECK_DUMP 1
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct
+{
+  const char       *name;
+  const ui_page_t  *page;   /* page->render(), or NULL to use `fn` */
+  void            (*fn)(uint32_t arg);
+  uint32_t          arg;
+  uint32_t          golden; /* CRC-32 of the packed frame, see render_check_pack() */
+} render_check_scenario_t;
+
+const render_check_scenario_t *render_check_scenarios(uint32_t *count);
+
+/* Reset the renderer and draw one scenario; the caller times this. */
+void render_check_draw(const render_check_scenario_t *scenario);
+
+/*
+ * Pack every row of the frame just drawn. Returns the panel stream and the
+ * CRC-32 of its line data, or NULL if the renderer did not hand out all rows.
+ */
+const uint8_t *render_check_pack(uint32_t *out_crc);
+
+/* Row 1..DISPLAY_HEIGHT of a packed frame as a P4 PBM row: LINE_WIDTH bytes. */
+void render_check_pbm_row(const uint8_t *frame, uint16_t row, uint8_t *out);
+
+/* Leave the renderer and the demo as the display task found them. */
+void render_check_end(void);
+
+void render_check_run(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RENDER_CHECK_H */
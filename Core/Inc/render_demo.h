@@ -1,6 +1,8 @@
 #ifndef RENDER_DEMO_H
 #define RENDER_DEMO_H
 
+#include <stdint.h>
+
 typedef enum
 {
   RENDER_DEMO_MODE_IDLE = 0,
@@ -16,7 +18,11 @@ void render_demo_set_mode(render_demo_mode_t mode);
 render_demo_mode_t render_demo_get_mode(void);
 void render_demo_toggle_background(void);
 void render_demo_toggle_cube(void);
+/* Post simulation ticks; the next draw advances the animation by them. */
+void render_demo_advance(uint32_t ticks);
 void render_demo_draw(void);
+/* render_demo_draw() at an explicit timebase, for reproducible frames. */
+void render_demo_draw_at(uint32_t now_ms);
 void render_demo_reset(void);
 
 #ifdef __cplusplus
@@ -45,6 +45,7 @@ typedef uint16_t sound_flags_t;
 #define SOUND_F_LOOP            (1U << 2U)
 #define SOUND_F_ALLOW_SLEEPFACE (1U << 3U)
 #define SOUND_F_STREAM          (1U << 4U)
+#define SOUND_F_PCM_CACHE       (1U << 5U)  /* Keep a decoded copy in the audio PCM cache */
 
 typedef enum
 {
@@ -88,6 +89,7 @@ const sound_registry_entry_t *sound_registry_get_by_path(const char *path);
 
 void sound_play(sound_id_t id);
 void sound_play_ex(sound_id_t id, sound_prio_t prio, sound_flags_t flags);
+void sound_preload(sound_id_t id);
 
 uint8_t sound_cache_get(sound_id_t id, const uint8_t **data, uint32_t *len);
 sound_cache_state_t sound_cache_get_state(sound_id_t id);
@@ -100,11 +102,15 @@ void sound_cache_set(sound_id_t id, uint32_t len, uint8_t ok);
 #define SOUND_CMD_TYPE_PLAY (1UL << SOUND_CMD_TYPE_SHIFT)
 #define SOUND_CMD_TYPE_STOP (2UL << SOUND_CMD_TYPE_SHIFT)
 #define SOUND_CMD_TYPE_STOP_ALL (3UL << SOUND_CMD_TYPE_SHIFT)
+#define SOUND_CMD_TYPE_PRELOAD (4UL << SOUND_CMD_TYPE_SHIFT)
 #define SOUND_CMD_ID_MASK 0xFFUL
 #define SOUND_CMD_PRIO_SHIFT 8U
 #define SOUND_CMD_PRIO_MASK 0xFUL
 #define SOUND_CMD_FLAGS_SHIFT 12U
 #define SOUND_CMD_FLAGS_MASK 0xFFFUL
+/* Play latency slot from audio_latency_mark_enqueue(); 0 = not timed. */
+#define SOUND_CMD_LAT_SHIFT 24U
+#define SOUND_CMD_LAT_MASK 0xFUL
 
 #define SOUND_CMD_MAKE_PLAY(id, prio, flags) \
   (SOUND_CMD_FLAG | SOUND_CMD_TYPE_PLAY \
@@ -119,6 +125,10 @@ void sound_cache_set(sound_id_t id, uint32_t len, uint8_t ok);
 #define SOUND_CMD_MAKE_STOP_ALL() \
   (SOUND_CMD_FLAG | SOUND_CMD_TYPE_STOP_ALL)
 
+#define SOUND_CMD_MAKE_PRELOAD(id) \
+  (SOUND_CMD_FLAG | SOUND_CMD_TYPE_PRELOAD \
+   | (((uint32_t)(id)) & SOUND_CMD_ID_MASK))
+
 #define SOUND_CMD_IS(cmd, type) \
   (((cmd) & (SOUND_CMD_FLAG | SOUND_CMD_TYPE_MASK)) == (SOUND_CMD_FLAG | (type)))
 
@@ -127,6 +137,8 @@ void sound_cache_set(sound_id_t id, uint32_t len, uint8_t ok);
   ((sound_prio_t)(((cmd) >> SOUND_CMD_PRIO_SHIFT) & SOUND_CMD_PRIO_MASK))
 #define SOUND_CMD_GET_FLAGS(cmd) \
   ((sound_flags_t)(((cmd) >> SOUND_CMD_FLAGS_SHIFT) & SOUND_CMD_FLAGS_MASK))
+#define SOUND_CMD_GET_LAT(cmd) \
+  ((uint8_t)(((cmd) >> SOUND_CMD_LAT_SHIFT) & SOUND_CMD_LAT_MASK))
 
 #ifdef __cplusplus
 }
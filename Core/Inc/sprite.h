@@ -0,0 +1,74 @@
+#ifndef SPRITE_H
+#define SPRITE_H
+
+#include "display_renderer.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Retained sprites on RENDER_LAYER_GAME.
+ *
+ * Setters only record changes; sprite_render() erases the old and new
+ * bounds of every changed sprite on the game layer and redraws, in z order,
+ * the parts of all visible sprites that fall inside them. The renderer then
+ * packs only the rows those rectangles touch, so moving a few sprites costs
+ * a few rows of panel traffic.
+ *
+ * The engine owns the game layer inside the rectangles it redraws. After
+ * anything else clears or draws over the game layer (renderFill(),
+ * renderClearLayer()), call sprite_invalidate_all().
+ */
+#define SPRITE_MAX_COUNT (16U)
+#define SPRITE_ID_INVALID (0xFFU)
+
+typedef uint8_t sprite_id_t;
+
+typedef enum
+{
+  SPRITE_FLIP_NONE = 0,
+  SPRITE_FLIP_X = 1,
+  SPRITE_FLIP_Y = 2,
+  SPRITE_FLIP_XY = 3
+} sprite_flip_t;
+
+/*
+ * 1bpp MSB-first rows (bit 7 is the leftmost pixel). Without a mask, set
+ * bitmap bits draw BLACK and clear bits are transparent. With a mask, set
+ * mask bits are opaque and draw WHITE unless the bitmap bit is also set;
+ * bitmap bits outside the mask must be clear.
+ */
+typedef struct
+{
+  const uint8_t *bitmap;
+  const uint8_t *mask;
+  uint16_t       width;
+  uint16_t       height;
+  uint16_t       stride_bytes;
+} sprite_image_t;
+
+void sprite_init(void);
+/* Returns SPRITE_ID_INVALID when the table is full. Sprites start visible. */
+sprite_id_t sprite_create(const sprite_image_t *image, int16_t x, int16_t y, int8_t z);
+void sprite_destroy(sprite_id_t id);
+void sprite_set_position(sprite_id_t id, int16_t x, int16_t y);
+void sprite_move_by(sprite_id_t id, int16_t dx, int16_t dy);
+void sprite_set_image(sprite_id_t id, const sprite_image_t *image);
+void sprite_set_flip(sprite_id_t id, sprite_flip_t flip);
+/* Higher z draws on top; equal z draws in creation order. */
+void sprite_set_z(sprite_id_t id, int8_t z);
+void sprite_set_visible(sprite_id_t id, bool visible);
+bool sprite_get_bounds(sprite_id_t id, render_rect_t *out);
+void sprite_invalidate_all(void);
+/* Apply pending changes to the game layer; returns the number of rectangles redrawn. */
+uint16_t sprite_render(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPRITE_H */
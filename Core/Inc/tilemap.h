@@ -0,0 +1,57 @@
+#ifndef TILEMAP_H
+#define TILEMAP_H
+
+#include "display_renderer.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TILEMAP_TILE_PIXELS (8U)
+
+/*
+ * A wrapping map of 8x8 1bpp tiles drawn into a logical view rectangle.
+ *
+ * Tiles are TILEMAP_TILE_PIXELS bytes each, one per row, MSB-first (bit 7 is
+ * the leftmost pixel); set bits draw BLACK and clear bits WHITE. The map is
+ * map_width x map_height tile indices, row-major, and repeats in both
+ * directions. The scroll position is the world pixel shown at the top-left
+ * of the view, which must lie on screen.
+ *
+ * tilemap_draw() remembers what it last drew: a pure translation since then
+ * scrolls the layer with renderScrollLayer() and draws only the newly exposed
+ * rows and columns. Call tilemap_invalidate() whenever something else has
+ * drawn over the view on that layer.
+ */
+typedef struct
+{
+  const uint8_t *tiles;
+  uint16_t       tile_count;
+  const uint8_t *map;
+  uint16_t       map_width;   /* in tiles */
+  uint16_t       map_height;  /* in tiles */
+  render_layer_t layer;
+  render_rect_t  view;
+
+  int32_t        scroll_x;
+  int32_t        scroll_y;
+  int32_t        drawn_x;
+  int32_t        drawn_y;
+  bool           drawn;
+} tilemap_t;
+
+void tilemap_init(tilemap_t *tm, const uint8_t *tiles, uint16_t tile_count, const uint8_t *map,
+                  uint16_t map_width, uint16_t map_height, render_layer_t layer, const render_rect_t *view);
+void tilemap_set_scroll(tilemap_t *tm, int32_t x, int32_t y);
+void tilemap_scroll_by(tilemap_t *tm, int32_t dx, int32_t dy);
+void tilemap_invalidate(tilemap_t *tm);
+void tilemap_draw(tilemap_t *tm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TILEMAP_H */
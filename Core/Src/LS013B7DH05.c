@@ -15,8 +15,9 @@
  *     [DUMMY 0x00]  (extra 8 clocks; total 16 after last line)
  *
  * IMPORTANT CHANGE:
- *   Buffer is stored in PANEL BYTE ORDER already.
- *   => flush does NOT do rev8() on pixel bytes.
+ *   Buffer is stored in PANEL BYTE ORDER already, framed as the stream above
+ *   (see LCD_STREAM_* in LS013B7DH05.h).
+ *   => flush does NOT do rev8() on pixel bytes and never copies rows.
  *
  * SPI:
  *   - 8-bit
@@ -33,13 +34,16 @@
 /* STM32U5 SPI TSIZE practical limit per HAL transmit/DMA chunk */
 #define SPI_TX_CHUNK_MAX (255u)
 
-/* Full-screen stream bytes:
- * 1 + H*(addr + data + dummy) + 1
- * = 1 + 168*(1+18+1) + 1 = 3362
+/* Put the DMA descriptors in SRAM4 for LPDMA.
+ *
+ * LPDMA fetches its linked-list nodes from memory, so they need the same
+ * placement as the stream buffers they point into. SRAM4 budget (16K, see
+ * STM32U575xx_FLASH.ld):
+ *   2 x LCD_DMA_NODE_MAX nodes (2 x 110 x 36)          =  7920
+ *   2 x stream framebuffer (3362, display_renderer.c) =  6724
+ *                                                      ------
+ *                                                      14644
  */
-#define TXBUF_MAX (1u + (DISPLAY_HEIGHT * (LINE_WIDTH + 2u)) + 1u)
-
-/* Put txBuf in SRAM4 for LPDMA */
 #if defined(__GNUC__)
   #define SRAM4_BUF_ATTR __attribute__((section(".sram4"))) __attribute__((aligned(4)))
 #elif defined(__ICCARM__)
@@ -48,81 +52,66 @@
   #define SRAM4_BUF_ATTR
 #endif
 
-static uint8_t txBuf[TXBUF_MAX] SRAM4_BUF_ATTR;
-
 /* --------------------------------------------------------------------------
- * Optional "zero-copy" transmit path
- *
- * The LCD write stream is:
- *   [CMD]
- *   repeat rows:
- *     [ROW_ADDR]
- *     [ROW_DATA bytes = LINE_WIDTH]
- *     [DUMMY 0x00]
- *   [FINAL_DUMMY 0x00]
+ * Zero-copy transmit
  *
- * For BLOCKING flush (HAL_SPI_Transmit), we can send this as a series of
- * small writes directly from the caller's buffer (no memcpy into txBuf).
+ * The caller's buffer already holds the whole write stream, so a flush is
+ * just a list of spans of it:
+ *   [CMD]                      stream[0]
+ *   one span per run of consecutive rows ([ADDR][DATA][DUMMY] ...)
+ *   [FINAL_DUMMY]              stream[LCD_STREAM_LENGTH - 1]
+ * Spans that touch are merged, so a full-screen flush is a single span.
  *
- * For DMA flush, zero-copy ONLY works if the caller's buffer resides in a
- * DMA-accessible memory region. If your framebuffer/packed buffer lives in
- * DTCM/CCM (or any non-DMA region), DMA will transmit garbage/zeros and the
- * display will appear blank.
- *
- * By default, DMA flush keeps the original safe behavior (BuildWriteBurst
- * into txBuf in SRAM4). You can opt-in to DMA zero-copy by defining:
- *   #define LS013B7DH05_DMA_ZERO_COPY 1
- * and ensuring the passed `buf` is in DMA-accessible RAM.
+ * Blocking flushes send the spans with HAL_SPI_Transmit. DMA flushes turn
+ * them into LPDMA linked-list queues (one queue per SPI transaction of at most
+ * SPI_TX_CHUNK_MAX bytes) whose nodes read the spans in place; the buffer must
+ * therefore be in SRAM4 and stay untouched until the transfer completes.
  * -------------------------------------------------------------------------- */
 
-#ifndef LS013B7DH05_DMA_ZERO_COPY
-#define LS013B7DH05_DMA_ZERO_COPY 0
-#endif
-
 typedef struct {
     const uint8_t *p;
     uint32_t       len;
 } lcd_seg_t;
 
-#define LCD_SEG_MAX (1u + (DISPLAY_HEIGHT * 3u) + 1u)
+/* Ascending rows form at most one run per two lines, plus CMD and FINAL_DUMMY. */
+#define LCD_SEG_MAX (2u + ((DISPLAY_HEIGHT + 1u) / 2u))
 
 static lcd_seg_t g_segs[LCD_SEG_MAX];
 static uint16_t  g_seg_count = 0u;
 
-static const uint8_t g_cmd_write = MLCD_CMD_WRITE;
-static const uint8_t g_dummy0    = 0x00u;
+static bool lcd_seg_append(const uint8_t *p, uint32_t len)
+{
+    lcd_seg_t *last = &g_segs[g_seg_count - 1u];
+    if ((last->p + last->len) == p) {
+        last->len += len;
+        return true;
+    }
+    if (g_seg_count >= LCD_SEG_MAX) return false;
 
-/* One byte per row address must persist until transmit finishes (DMA case). */
-static uint8_t g_row_addr[DISPLAY_HEIGHT] SRAM4_BUF_ATTR;
+    g_segs[g_seg_count++] = (lcd_seg_t){ .p = p, .len = len };
+    return true;
+}
 
-static HAL_StatusTypeDef BuildWriteSegments(const uint8_t *buf,
+/* rows[] are 1-based gate lines (1..DISPLAY_HEIGHT), normally ascending. */
+static HAL_StatusTypeDef BuildWriteSegments(const uint8_t *stream,
                                             const uint16_t *rows,
                                             uint16_t rowCount)
 {
-    if (!buf || !rows || rowCount == 0u) return HAL_ERROR;
+    g_seg_count = 0u;
+    if (!stream || !rows || rowCount == 0u) return HAL_ERROR;
     if (rowCount > DISPLAY_HEIGHT) return HAL_ERROR;
 
-    uint16_t si = 0u;
-
-    g_segs[si++] = (lcd_seg_t){ .p = &g_cmd_write, .len = 1u };
+    g_segs[g_seg_count++] = (lcd_seg_t){ .p = &stream[0], .len = 1u };
 
     for (uint16_t i = 0; i < rowCount; i++) {
         uint16_t r = rows[i];
         if (r < 1u || r > DISPLAY_HEIGHT) return HAL_ERROR;
 
-        g_row_addr[i] = (uint8_t)r;
-
-        g_segs[si++] = (lcd_seg_t){ .p = &g_row_addr[i], .len = 1u };
-
-        uint32_t offset = (uint32_t)(r - 1u) * LINE_WIDTH;
-        g_segs[si++] = (lcd_seg_t){ .p = &buf[offset], .len = (uint32_t)LINE_WIDTH };
-
-        g_segs[si++] = (lcd_seg_t){ .p = &g_dummy0, .len = 1u };
+        if (!lcd_seg_append(&stream[LCD_STREAM_LINE_OFFSET(r)], LCD_STREAM_LINE_STRIDE)) return HAL_ERROR;
     }
 
-    g_segs[si++] = (lcd_seg_t){ .p = &g_dummy0, .len = 1u };
+    if (!lcd_seg_append(&stream[LCD_STREAM_LENGTH - 1u], 1u)) return HAL_ERROR;
 
-    g_seg_count = si;
     return HAL_OK;
 }
 
@@ -155,40 +144,6 @@ static HAL_StatusTypeDef spi_tx_chunked(LS013B7DH05 *d, const uint8_t *buf, uint
     return HAL_OK;
 }
 
-/* --------------------------- Build write burst ----------------------------- */
-/* rows[] are 1-based gate lines (1..DISPLAY_HEIGHT). */
-static HAL_StatusTypeDef BuildWriteBurst(const uint8_t *buf, const uint16_t *rows,
-                                         uint16_t rowCount, uint16_t *outLen)
-{
-    if (!outLen || !buf || !rows || rowCount == 0u) return HAL_ERROR;
-    *outLen = 0;
-
-    uint32_t needed = 1u + ((uint32_t)rowCount * (1u + LINE_WIDTH + 1u)) + 1u;
-    if (needed > TXBUF_MAX) return HAL_ERROR;
-
-    uint32_t w = 0u;
-    txBuf[w++] = MLCD_CMD_WRITE;
-
-    for (uint16_t i = 0; i < rowCount; i++) {
-        uint16_t r = rows[i];
-        if (r < 1u || r > DISPLAY_HEIGHT) return HAL_ERROR;
-
-        txBuf[w++] = (uint8_t)r;
-
-        uint32_t offset = (uint32_t)(r - 1u) * LINE_WIDTH;
-
-        /* NO rev8(): buffer is already in panel order */
-        memcpy(&txBuf[w], &buf[offset], LINE_WIDTH);
-        w += LINE_WIDTH;
-
-        txBuf[w++] = 0x00u; /* per-line dummy */
-    }
-
-    txBuf[w++] = 0x00u; /* final dummy */
-    *outLen = (uint16_t)w;
-    return HAL_OK;
-}
-
 /* --------------------------- Public: init/clean ---------------------------- */
 HAL_StatusTypeDef LCD_Init(LS013B7DH05 *MemDisp,
                            SPI_HandleTypeDef *Bus,
@@ -217,19 +172,26 @@ HAL_StatusTypeDef LCD_Clean(LS013B7DH05 *MemDisp)
     return st;
 }
 
+void LCD_StreamInit(uint8_t *stream)
+{
+    if (!stream) return;
+
+    stream[0] = MLCD_CMD_WRITE;
+    for (uint16_t r = 1u; r <= DISPLAY_HEIGHT; r++) {
+        uint8_t *line = &stream[LCD_STREAM_LINE_OFFSET(r)];
+        line[0] = (uint8_t)r;
+        line[1u + LINE_WIDTH] = 0x00u; /* per-line dummy */
+    }
+    stream[LCD_STREAM_LENGTH - 1u] = 0x00u; /* final dummy */
+}
+
 /* --------------------------- Public: blocking flush ------------------------ */
 HAL_StatusTypeDef LCD_FlushAll(LS013B7DH05 *MemDisp, const uint8_t *buf)
 {
     if (!MemDisp || !buf) return HAL_ERROR;
 
-    static uint16_t allRows[DISPLAY_HEIGHT];
-    for (uint16_t i = 0; i < DISPLAY_HEIGHT; i++) allRows[i] = (uint16_t)(i + 1u);
-
-    HAL_StatusTypeDef st = BuildWriteSegments(buf, allRows, DISPLAY_HEIGHT);
-    if (st != HAL_OK) return st;
-
     SCS_High(MemDisp);
-    st = spi_tx_segments_chunked(MemDisp);
+    HAL_StatusTypeDef st = spi_tx_chunked(MemDisp, buf, LCD_STREAM_LENGTH);
     SCS_Low(MemDisp);
 
     return st;
@@ -240,12 +202,11 @@ HAL_StatusTypeDef LCD_FlushRows(LS013B7DH05 *MemDisp, const uint8_t *buf,
 {
     if (!MemDisp || !buf) return HAL_ERROR;
 
-    uint16_t len = 0;
-    HAL_StatusTypeDef st = BuildWriteBurst(buf, rows, rowCount, &len);
+    HAL_StatusTypeDef st = BuildWriteSegments(buf, rows, rowCount);
     if (st != HAL_OK) return st;
 
     SCS_High(MemDisp);
-    st = spi_tx_chunked(MemDisp, txBuf, len);
+    st = spi_tx_segments_chunked(MemDisp);
     SCS_Low(MemDisp);
 
     return st;
@@ -253,10 +214,12 @@ HAL_StatusTypeDef LCD_FlushRows(LS013B7DH05 *MemDisp, const uint8_t *buf,
 
 /* --------------------------- DMA chunk chaining ---------------------------- */
 typedef struct {
-    LS013B7DH05     *dev;
-    const uint8_t *p;
-    uint32_t       remaining;
-    HAL_StatusTypeDef last;
+    LS013B7DH05       *dev;
+    struct lcd_dma_slot *slot;
+    volatile uint8_t   xfer;       /* transaction currently on the wire */
+    volatile bool      streaming;  /* producer may still publish transactions */
+    volatile bool      waiting;    /* chain ran dry; the producer restarts it */
+    HAL_StatusTypeDef  last;
 } lcd_dma_chain_t;
 
 static volatile bool g_dma_done = true;
@@ -272,33 +235,352 @@ __weak void LCD_FlushDmaErrorCallback(void)
 {
 }
 
+/* --------------------------- LPDMA descriptor slots ------------------------ */
+/* A full frame needs at most this many 255-byte transactions. */
+#define LCD_DMA_XFER_FULL ((LCD_STREAM_LENGTH + SPI_TX_CHUNK_MAX - 1u) / SPI_TX_CHUNK_MAX) /* 14 */
+/* Streaming may close up to 10 short transactions early to keep the wire busy. */
+#define LCD_DMA_XFER_MAX  (LCD_DMA_XFER_FULL + 10u)
+/* Every node ends either a span or a transaction. */
+#define LCD_DMA_NODE_MAX  (LCD_SEG_MAX + LCD_DMA_XFER_MAX)                                 /* 110 */
+#define LCD_DMA_SLOTS     (2u)
+
+/* Two slots: a flush can be built in the idle one while the other is still
+ * on the wire. A slot remembers which stream and rows its queues were built
+ * for, so restaging the same row set is free. */
+typedef struct lcd_dma_slot {
+    DMA_QListTypeDef  queue[LCD_DMA_XFER_MAX];
+    uint16_t          xferLen[LCD_DMA_XFER_MAX];
+    volatile uint8_t  xferCount;   /* transactions ready for the wire */
+    const uint8_t    *stream;      /* NULL until the slot is complete */
+    uint16_t          rows[DISPLAY_HEIGHT];
+    uint16_t          rowCount;
+} lcd_dma_slot_t;
+
+/* Builds a slot incrementally: spans of the stream are appended in order and
+ * cut into nodes and transactions, each transaction being published to the
+ * slot as soon as it is full. */
+typedef struct {
+    lcd_dma_slot_t     *slot;
+    DMA_NodeTypeDef    *nodes;
+    const uint8_t      *stream;
+    DMA_NodeConfTypeDef conf;
+    uint16_t            nodeCount;
+    uint8_t             xfer;       /* transaction being filled */
+    uint32_t            xferBytes;
+    const uint8_t      *spanP;      /* span not yet cut into nodes */
+    uint32_t            spanLen;
+    uint16_t            lastRow;
+} lcd_dma_build_t;
+
+static DMA_NodeTypeDef g_dma_nodes[LCD_DMA_SLOTS][LCD_DMA_NODE_MAX] SRAM4_BUF_ATTR;
+static lcd_dma_slot_t  g_dma_slots[LCD_DMA_SLOTS];
+static uint8_t         g_tx_next = 0u;      /* slot the next flush is built into */
+static bool            g_tx_staged = false;
+static bool            g_dma_list_ready = false;
+
+static HAL_StatusTypeDef lcd_dma_kick_next(void);
+
+static void lcd_dma_finish(HAL_StatusTypeDef st)
+{
+    SCS_Low(g_chain.dev);
+    (void)HAL_DMAEx_List_UnLinkQ(g_chain.dev->Bus->hdmatx);
+    g_chain.last = st;
+    g_chain.streaming = false;
+    g_chain.waiting = false;
+    g_chain.dev = NULL;
+    g_dma_done = true;
+
+    if (st == HAL_OK) LCD_FlushDmaDoneCallback();
+    else LCD_FlushDmaErrorCallback();
+}
+
+/* Switch the SPI TX channel to linear linked-list mode once. */
+static HAL_StatusTypeDef lcd_dma_list_init(SPI_HandleTypeDef *bus)
+{
+    if (g_dma_list_ready) return HAL_OK;
+
+    DMA_HandleTypeDef *hdma = bus->hdmatx;
+    if (!hdma) return HAL_ERROR;
+
+    hdma->InitLinkedList.Priority = hdma->Init.Priority;
+    hdma->InitLinkedList.LinkStepMode = DMA_LSM_FULL_EXECUTION;
+    hdma->InitLinkedList.LinkAllocatedPort = DMA_LINK_ALLOCATED_PORT0;
+    hdma->InitLinkedList.TransferEventMode = DMA_TCEM_LAST_LL_ITEM_TRANSFER;
+    hdma->InitLinkedList.LinkedListMode = DMA_LINKEDLIST_NORMAL;
+
+    if (HAL_DMAEx_List_Init(hdma) != HAL_OK) {
+        hdma->Init.Mode = DMA_NORMAL;
+        (void)HAL_DMA_Init(hdma);
+        return HAL_ERROR;
+    }
+
+    for (uint8_t s = 0u; s < LCD_DMA_SLOTS; s++) {
+        for (uint8_t x = 0u; x < LCD_DMA_XFER_MAX; x++) {
+            g_dma_slots[s].queue[x].Type = QUEUE_TYPE_STATIC;
+        }
+    }
+
+    g_dma_list_ready = true;
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef lcd_dma_build_begin(lcd_dma_build_t *b, SPI_HandleTypeDef *bus,
+                                             uint8_t s, const uint8_t *stream)
+{
+    b->slot = &g_dma_slots[s];
+    b->nodes = g_dma_nodes[s];
+    b->stream = stream;
+    b->nodeCount = 0u;
+    b->xfer = 0u;
+    b->xferBytes = 0u;
+    b->spanP = NULL;
+    b->spanLen = 0u;
+    b->lastRow = 0u;
+
+    b->slot->xferCount = 0u;
+    b->slot->stream = NULL;
+    b->slot->rowCount = 0u;
+
+    memset(&b->conf, 0, sizeof(b->conf));
+    b->conf.NodeType = DMA_LPDMA_LINEAR_NODE;
+    b->conf.Init = bus->hdmatx->Init;
+    b->conf.Init.TransferEventMode = DMA_TCEM_LAST_LL_ITEM_TRANSFER;
+    b->conf.DataHandlingConfig.DataExchange = DMA_EXCHANGE_NONE;
+    b->conf.DataHandlingConfig.DataAlignment = DMA_DATA_RIGHTALIGN_ZEROPADDED;
+    b->conf.TriggerConfig.TriggerMode = DMA_TRIGM_BLOCK_TRANSFER;
+    b->conf.TriggerConfig.TriggerPolarity = DMA_TRIG_POLARITY_MASKED;
+    b->conf.TriggerConfig.TriggerSelection = 0U;
+    b->conf.DstAddress = (uint32_t)&bus->Instance->TXDR;
+
+    for (uint8_t x = 0u; x < LCD_DMA_XFER_MAX; x++) {
+        if (HAL_DMAEx_List_ResetQ(&b->slot->queue[x]) != HAL_OK) return HAL_ERROR;
+    }
+
+    /* WRITE_CMD */
+    b->spanP = &stream[0];
+    b->spanLen = 1u;
+    return HAL_OK;
+}
+
+/* Make `count` transactions of `slot` visible to the chain. If the chain is
+ * streaming from this slot and ran dry, restart it from here. `last` ends the
+ * stream: the chain completes once it has sent what is published. */
+static HAL_StatusTypeDef lcd_dma_publish(lcd_dma_slot_t *slot, uint8_t count, bool last)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    slot->xferCount = count;
+    bool ours = (g_chain.dev != NULL) && (g_chain.slot == slot);
+    bool resume = ours && g_chain.waiting && (last || (g_chain.xfer < count));
+    if (ours && last) g_chain.streaming = false;
+    if (resume) g_chain.waiting = false;
+    __set_PRIMASK(primask);
+
+    if (!resume) return HAL_OK;
+
+    if (g_chain.xfer >= count) {
+        /* Everything was already on the wire. */
+        lcd_dma_finish(g_chain.last);
+        return HAL_OK;
+    }
+
+    HAL_StatusTypeDef st = lcd_dma_kick_next();
+    if (st != HAL_OK) lcd_dma_finish(st);
+    return st;
+}
+
+static HAL_StatusTypeDef lcd_dma_xfer_close(lcd_dma_build_t *b, bool last)
+{
+    if (b->xferBytes != 0u) {
+        b->slot->xferLen[b->xfer++] = (uint16_t)b->xferBytes;
+        b->xferBytes = 0u;
+    } else if (!last) {
+        return HAL_OK;
+    }
+    return lcd_dma_publish(b->slot, b->xfer, last);
+}
+
+/* Cut the pending span into nodes. Unless `all`, a tail too short to fill
+ * the current transaction stays pending, since the next span may extend it. */
+static HAL_StatusTypeDef lcd_dma_span_drain(lcd_dma_build_t *b, bool all)
+{
+    while (b->spanLen > 0u) {
+        uint32_t room = SPI_TX_CHUNK_MAX - b->xferBytes;
+        if (!all && b->spanLen < room) break;
+        if (b->xfer >= LCD_DMA_XFER_MAX || b->nodeCount >= LCD_DMA_NODE_MAX) return HAL_ERROR;
+
+        uint32_t n = (b->spanLen < room) ? b->spanLen : room;
+        DMA_NodeTypeDef *node = &b->nodes[b->nodeCount];
+
+        b->conf.SrcAddress = (uint32_t)b->spanP;
+        b->conf.DataSize = n;
+        if (HAL_DMAEx_List_BuildNode(&b->conf, node) != HAL_OK) return HAL_ERROR;
+        if (HAL_DMAEx_List_InsertNode_Tail(&b->slot->queue[b->xfer], node) != HAL_OK) return HAL_ERROR;
+        b->nodeCount++;
+
+        b->spanP += n;
+        b->spanLen -= n;
+        b->xferBytes += n;
+
+        if (b->xferBytes == SPI_TX_CHUNK_MAX) {
+            HAL_StatusTypeDef st = lcd_dma_xfer_close(b, false);
+            if (st != HAL_OK) return st;
+        }
+    }
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef lcd_dma_span_add(lcd_dma_build_t *b, const uint8_t *p, uint32_t len)
+{
+    if (b->spanLen != 0u && (b->spanP + b->spanLen) != p) {
+        HAL_StatusTypeDef st = lcd_dma_span_drain(b, true);
+        if (st != HAL_OK) return st;
+    }
+    if (b->spanLen == 0u) b->spanP = p;
+    b->spanLen += len;
+
+    return lcd_dma_span_drain(b, false);
+}
+
+/* rows[] must ascend across calls; that bounds the node count (LCD_SEG_MAX). */
+static HAL_StatusTypeDef lcd_dma_build_rows(lcd_dma_build_t *b, const uint16_t *rows, uint16_t rowCount)
+{
+    if (!rows) return HAL_ERROR;
+
+    for (uint16_t i = 0; i < rowCount; i++) {
+        uint16_t r = rows[i];
+        if (r <= b->lastRow || r > DISPLAY_HEIGHT) return HAL_ERROR;
+
+        b->lastRow = r;
+        b->slot->rows[b->slot->rowCount++] = r;
+
+        HAL_StatusTypeDef st = lcd_dma_span_add(b, &b->stream[LCD_STREAM_LINE_OFFSET(r)], LCD_STREAM_LINE_STRIDE);
+        if (st != HAL_OK) return st;
+    }
+    return HAL_OK;
+}
+
+static HAL_StatusTypeDef lcd_dma_build_end(lcd_dma_build_t *b)
+{
+    /* FINAL_DUMMY */
+    HAL_StatusTypeDef st = lcd_dma_span_add(b, &b->stream[LCD_STREAM_LENGTH - 1u], 1u);
+    if (st == HAL_OK) st = lcd_dma_span_drain(b, true);
+    if (st == HAL_OK) st = lcd_dma_xfer_close(b, true);
+    if (st == HAL_OK) b->slot->stream = b->stream;
+    return st;
+}
+
+/* Same completion handling as HAL's normal-mode SPI TX DMA: let EOT finish it. */
+static void lcd_dma_xfer_cplt(DMA_HandleTypeDef *hdma)
+{
+    SPI_HandleTypeDef *hspi = (SPI_HandleTypeDef *)hdma->Parent;
+    if (hspi->State != HAL_SPI_STATE_ABORT) __HAL_SPI_ENABLE_IT(hspi, SPI_IT_EOT);
+}
+
+static void lcd_dma_xfer_error(DMA_HandleTypeDef *hdma)
+{
+    SPI_HandleTypeDef *hspi = (SPI_HandleTypeDef *)hdma->Parent;
+
+    __HAL_SPI_DISABLE_IT(hspi, (SPI_IT_EOT | SPI_IT_TXP | SPI_IT_UDR | SPI_IT_FRE | SPI_IT_MODF));
+    CLEAR_BIT(hspi->Instance->CFG1, SPI_CFG1_TXDMAEN);
+    __HAL_SPI_DISABLE(hspi);
+    __HAL_SPI_CLEAR_EOTFLAG(hspi);
+    __HAL_SPI_CLEAR_TXTFFLAG(hspi);
+
+    SET_BIT(hspi->ErrorCode, HAL_SPI_ERROR_DMA);
+    hspi->State = HAL_SPI_STATE_READY;
+    HAL_SPI_ErrorCallback(hspi);
+}
+
+/* HAL_SPI_Transmit_DMA() without its linked-list handling, which rewrites the
+ * head node with a single (pData, Size) block: start the queue already linked
+ * to the channel as one SPI transaction of `size` bytes. */
+static HAL_StatusTypeDef lcd_spi_tx_queue(SPI_HandleTypeDef *hspi, uint16_t size)
+{
+    if (hspi->State != HAL_SPI_STATE_READY) return HAL_BUSY;
+
+    __HAL_LOCK(hspi);
+
+    hspi->State       = HAL_SPI_STATE_BUSY_TX;
+    hspi->ErrorCode   = HAL_SPI_ERROR_NONE;
+    hspi->pTxBuffPtr  = NULL;
+    hspi->TxXferSize  = size;
+    hspi->TxXferCount = size;
+    hspi->pRxBuffPtr  = NULL;
+    hspi->TxISR       = NULL;
+    hspi->RxISR       = NULL;
+    hspi->RxXferSize  = 0u;
+    hspi->RxXferCount = 0u;
+
+    SPI_2LINES_TX(hspi);
+
+    hspi->hdmatx->XferHalfCpltCallback = NULL;
+    hspi->hdmatx->XferCpltCallback     = lcd_dma_xfer_cplt;
+    hspi->hdmatx->XferErrorCallback    = lcd_dma_xfer_error;
+    hspi->hdmatx->XferAbortCallback    = NULL;
+
+    CLEAR_BIT(hspi->Instance->CFG1, SPI_CFG1_TXDMAEN);
+
+    if (HAL_DMAEx_List_Start_IT(hspi->hdmatx) != HAL_OK) {
+        SET_BIT(hspi->ErrorCode, HAL_SPI_ERROR_DMA);
+        hspi->State = HAL_SPI_STATE_READY;
+        __HAL_UNLOCK(hspi);
+        return HAL_ERROR;
+    }
+
+    MODIFY_REG(hspi->Instance->CR2, SPI_CR2_TSIZE, size);
+    SET_BIT(hspi->Instance->CFG1, SPI_CFG1_TXDMAEN);
+    __HAL_SPI_ENABLE_IT(hspi, (SPI_IT_UDR | SPI_IT_FRE | SPI_IT_MODF));
+    __HAL_SPI_ENABLE(hspi);
+    SET_BIT(hspi->Instance->CR1, SPI_CR1_CSTART);
+
+    __HAL_UNLOCK(hspi);
+    return HAL_OK;
+}
+
 static HAL_StatusTypeDef lcd_dma_kick_next(void)
 {
-    if (!g_chain.dev) return HAL_ERROR;
-    if (g_chain.remaining == 0u) return HAL_OK;
+    if (!g_chain.dev || !g_chain.slot) return HAL_ERROR;
+    if (g_chain.xfer >= g_chain.slot->xferCount) return HAL_OK;
 
-    uint16_t n = (g_chain.remaining > SPI_TX_CHUNK_MAX) ? (uint16_t)SPI_TX_CHUNK_MAX
-                                                        : (uint16_t)g_chain.remaining;
-    return HAL_SPI_Transmit_DMA(g_chain.dev->Bus, (uint8_t*)g_chain.p, n);
+    SPI_HandleTypeDef *bus = g_chain.dev->Bus;
+    (void)HAL_DMAEx_List_UnLinkQ(bus->hdmatx);
+    HAL_StatusTypeDef st = HAL_DMAEx_List_LinkQ(bus->hdmatx, &g_chain.slot->queue[g_chain.xfer]);
+    if (st != HAL_OK) return st;
+
+    return lcd_spi_tx_queue(bus, g_chain.slot->xferLen[g_chain.xfer]);
 }
 
-static HAL_StatusTypeDef lcd_dma_start(LS013B7DH05 *dev, const uint8_t *buf, uint32_t len)
+/* Claim the bus for a transfer out of `slot`; nothing is sent until a
+ * published transaction is kicked. */
+static HAL_StatusTypeDef lcd_dma_open(LS013B7DH05 *dev, lcd_dma_slot_t *slot, bool streaming)
 {
-    if (!dev || !buf || len == 0u) return HAL_ERROR;
     if (!g_dma_done) return HAL_BUSY;
 
     g_chain.dev = dev;
-    g_chain.p = buf;
-    g_chain.remaining = len;
+    g_chain.slot = slot;
+    g_chain.xfer = 0u;
+    g_chain.streaming = streaming;
+    g_chain.waiting = streaming;
     g_chain.last = HAL_OK;
 
     g_dma_done = false;
 
     SCS_High(dev);
+    return HAL_OK;
+}
 
-    HAL_StatusTypeDef st = lcd_dma_kick_next();
+static HAL_StatusTypeDef lcd_dma_start(LS013B7DH05 *dev, lcd_dma_slot_t *slot)
+{
+    if (!dev || !slot || slot->xferCount == 0u) return HAL_ERROR;
+
+    HAL_StatusTypeDef st = lcd_dma_open(dev, slot, false);
+    if (st != HAL_OK) return st;
+
+    st = lcd_dma_kick_next();
     if (st != HAL_OK) {
         SCS_Low(dev);
+        (void)HAL_DMAEx_List_UnLinkQ(dev->Bus->hdmatx);
         g_chain.dev = NULL;
         g_dma_done = true;
         return st;
@@ -311,27 +593,20 @@ void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
     if (!g_chain.dev || !g_chain.dev->Bus) return;
     if (hspi != g_chain.dev->Bus) return;
 
-    uint32_t sent = (g_chain.remaining > SPI_TX_CHUNK_MAX) ? (uint32_t)SPI_TX_CHUNK_MAX : g_chain.remaining;
+    g_chain.xfer++;
 
-    g_chain.p += sent;
-    g_chain.remaining -= sent;
-
-    if (g_chain.remaining == 0u) {
-        SCS_Low(g_chain.dev);
-        g_chain.dev = NULL;
-        g_dma_done = true;
-        LCD_FlushDmaDoneCallback();
+    if (g_chain.xfer >= g_chain.slot->xferCount) {
+        if (g_chain.streaming) {
+            /* Producer is still packing; lcd_dma_publish() resumes. */
+            g_chain.waiting = true;
+            return;
+        }
+        lcd_dma_finish(g_chain.last);
         return;
     }
 
     HAL_StatusTypeDef st = lcd_dma_kick_next();
-    if (st != HAL_OK) {
-        SCS_Low(g_chain.dev);
-        g_chain.last = st;
-        g_chain.dev = NULL;
-        g_dma_done = true;
-        LCD_FlushDmaErrorCallback();
-    }
+    if (st != HAL_OK) lcd_dma_finish(st);
 }
 
 void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
@@ -339,50 +614,163 @@ void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
     if (!g_chain.dev || !g_chain.dev->Bus) return;
     if (hspi != g_chain.dev->Bus) return;
 
-    SCS_Low(g_chain.dev);
-    g_chain.last = HAL_ERROR;
-    g_chain.dev = NULL;
-    g_dma_done = true;
-    LCD_FlushDmaErrorCallback();
+    /* HAL has already aborted the channel (or it stopped on its own error). */
+    lcd_dma_finish(HAL_ERROR);
 }
 
-HAL_StatusTypeDef LCD_FlushAll_DMA(LS013B7DH05 *MemDisp, const uint8_t *buf)
+/* --------------------------- Staged (ping-pong) DMA ------------------------ */
+static const uint16_t *lcd_all_rows(void)
 {
-    if (!MemDisp || !buf) return HAL_ERROR;
-
     static uint16_t allRows[DISPLAY_HEIGHT];
-    for (uint16_t i = 0; i < DISPLAY_HEIGHT; i++) allRows[i] = (uint16_t)(i + 1u);
+    if (allRows[0] == 0u) {
+        for (uint16_t i = 0; i < DISPLAY_HEIGHT; i++) allRows[i] = (uint16_t)(i + 1u);
+    }
+    return allRows;
+}
 
-    uint16_t len = 0;
-    HAL_StatusTypeDef st = BuildWriteBurst(buf, allRows, DISPLAY_HEIGHT, &len);
+HAL_StatusTypeDef LCD_StageRows_DMA(LS013B7DH05 *MemDisp, const uint8_t *buf,
+                                    const uint16_t *rows, uint16_t rowCount)
+{
+    if (!MemDisp || !buf || !rows) return HAL_ERROR;
+    if (rowCount == 0u || rowCount > DISPLAY_HEIGHT) return HAL_ERROR;
+
+    g_tx_staged = false;
+    HAL_StatusTypeDef st = lcd_dma_list_init(MemDisp->Bus);
     if (st != HAL_OK) return st;
 
-    return lcd_dma_start(MemDisp, txBuf, len);
+    /* The idle slot is never the one an in-flight transfer is reading. */
+    lcd_dma_slot_t *slot = &g_dma_slots[g_tx_next];
+    if (slot->stream == buf && slot->rowCount == rowCount &&
+        memcmp(slot->rows, rows, (size_t)rowCount * sizeof(rows[0])) == 0) {
+        g_tx_staged = true;
+        return HAL_OK;
+    }
+
+    lcd_dma_build_t b;
+    st = lcd_dma_build_begin(&b, MemDisp->Bus, g_tx_next, buf);
+    if (st == HAL_OK) st = lcd_dma_build_rows(&b, rows, rowCount);
+    if (st == HAL_OK) st = lcd_dma_build_end(&b);
+    if (st != HAL_OK) {
+        slot->xferCount = 0u;
+        slot->stream = NULL;
+        return st;
+    }
+
+    g_tx_staged = true;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef LCD_StageAll_DMA(LS013B7DH05 *MemDisp, const uint8_t *buf)
+{
+    return LCD_StageRows_DMA(MemDisp, buf, lcd_all_rows(), DISPLAY_HEIGHT);
+}
+
+HAL_StatusTypeDef LCD_StartStaged_DMA(LS013B7DH05 *MemDisp)
+{
+    if (!MemDisp || !g_tx_staged) return HAL_ERROR;
+
+    HAL_StatusTypeDef st = lcd_dma_start(MemDisp, &g_dma_slots[g_tx_next]);
+    if (st != HAL_OK) return st;
+
+    g_tx_staged = false;
+    g_tx_next ^= 1u;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef LCD_FlushAll_DMA(LS013B7DH05 *MemDisp, const uint8_t *buf)
+{
+    HAL_StatusTypeDef st = LCD_StageAll_DMA(MemDisp, buf);
+    if (st != HAL_OK) return st;
+
+    return LCD_StartStaged_DMA(MemDisp);
 }
 
 HAL_StatusTypeDef LCD_FlushRows_DMA(LS013B7DH05 *MemDisp, const uint8_t *buf,
                                     const uint16_t *rows, uint16_t rowCount)
+{
+    HAL_StatusTypeDef st = LCD_StageRows_DMA(MemDisp, buf, rows, rowCount);
+    if (st != HAL_OK) return st;
+
+    return LCD_StartStaged_DMA(MemDisp);
+}
+
+/* --------------------------- Streaming DMA --------------------------------- */
+static lcd_dma_build_t g_stream;
+static bool            g_stream_open = false;
+
+/* Stop feeding the chain. Whatever is already on the wire finishes first;
+ * the transfer then completes with `st`. */
+static void lcd_dma_stream_fail(HAL_StatusTypeDef st)
+{
+    g_stream_open = false;
+    g_stream.slot->xferCount = 0u;
+    g_stream.slot->stream = NULL;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    bool ours = (g_chain.dev != NULL) && (g_chain.slot == g_stream.slot);
+    bool idle = ours && g_chain.waiting;
+    if (ours) {
+        g_chain.last = st;
+        g_chain.streaming = false;
+        g_chain.waiting = false;
+    }
+    __set_PRIMASK(primask);
+
+    if (idle) lcd_dma_finish(st);
+}
+
+HAL_StatusTypeDef LCD_StreamBegin_DMA(LS013B7DH05 *MemDisp, const uint8_t *buf)
 {
     if (!MemDisp || !buf) return HAL_ERROR;
+    if (g_stream_open || !g_dma_done) return HAL_BUSY;
 
-#if LS013B7DH05_DMA_ZERO_COPY
-    /* WARNING: caller's buf must be in DMA-accessible RAM */
-    HAL_StatusTypeDef st = BuildWriteSegments(buf, rows, rowCount);
+    /* Streaming builds into the idle slot, replacing anything staged there. */
+    g_tx_staged = false;
+    HAL_StatusTypeDef st = lcd_dma_list_init(MemDisp->Bus);
+    if (st == HAL_OK) st = lcd_dma_build_begin(&g_stream, MemDisp->Bus, g_tx_next, buf);
+    if (st != HAL_OK) {
+        g_dma_slots[g_tx_next].stream = NULL;
+        return st;
+    }
+
+    st = lcd_dma_open(MemDisp, g_stream.slot, true);
     if (st != HAL_OK) return st;
 
-    /* Reuse the existing DMA chunk-chaining infrastructure by DMA'ing each
-     * segment back-to-back is NOT supported here. For full DMA zero-copy,
-     * keep using the separate zero-copy DMA implementation.
-     *
-     * This build keeps the safe txBuf DMA path by default.
-     */
-#endif
+    g_stream_open = true;
+    return HAL_OK;
+}
 
-    uint16_t len = 0;
-    HAL_StatusTypeDef st = BuildWriteBurst(buf, rows, rowCount, &len);
-    if (st != HAL_OK) return st;
+HAL_StatusTypeDef LCD_StreamRows_DMA(LS013B7DH05 *MemDisp, const uint16_t *rows, uint16_t rowCount)
+{
+    if (!MemDisp || !g_stream_open) return HAL_ERROR;
+
+    HAL_StatusTypeDef st = (g_chain.dev == MemDisp) ? lcd_dma_build_rows(&g_stream, rows, rowCount) : HAL_ERROR;
 
-    return lcd_dma_start(MemDisp, txBuf, len);
+    /* If the wire ran dry, send what is packed now instead of waiting for a
+     * full transaction, while the budget for short ones lasts. */
+    if (st == HAL_OK && g_chain.waiting && g_stream.xfer < (LCD_DMA_XFER_MAX - LCD_DMA_XFER_FULL)) {
+        st = lcd_dma_span_drain(&g_stream, true);
+        if (st == HAL_OK) st = lcd_dma_xfer_close(&g_stream, false);
+    }
+
+    if (st != HAL_OK) lcd_dma_stream_fail(st);
+    return st;
+}
+
+HAL_StatusTypeDef LCD_StreamEnd_DMA(LS013B7DH05 *MemDisp)
+{
+    if (!MemDisp || !g_stream_open) return HAL_ERROR;
+
+    HAL_StatusTypeDef st = (g_chain.dev == MemDisp) ? lcd_dma_build_end(&g_stream) : HAL_ERROR;
+    if (st != HAL_OK) {
+        lcd_dma_stream_fail(st);
+        return st;
+    }
+
+    g_stream_open = false;
+    g_tx_next ^= 1u;
+    return HAL_OK;
 }
 
 HAL_StatusTypeDef LCD_FlushDMA_WaitWFI(uint32_t timeout_ms)
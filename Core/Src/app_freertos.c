@@ -599,6 +599,8 @@ static void app_input_process_event(const app_input_event_t *evt)
       }
       else
       {
+        /* The sleep face paused the demo; tskGame waits for a wake to resume it. */
+        game_task_wake();
         app_display_cmd_t cmd = APP_DISPLAY_CMD_RENDER_DEMO;
         (void)osMessageQueuePut(qDisplayCmdHandle, &cmd, 0U, 0U);
       }
@@ -0,0 +1,389 @@
+/*
+ * audio_adpcm.c
+ *
+ * IMA-ADPCM decoding for the audio mixer (see audio_adpcm.h):
+ *  - Whole blocks decode straight into the output; partial blocks resume
+ *    mid-byte from the saved state
+ *  - Streamed blocks are read from the storage ring in runs of up to
+ *    ADPCM_STREAM_READ_BYTES
+ *
+ * Notes:
+ *  - Host/test_audio_adpcm.c checks both decoders against the per-sample
+ *    decoders they replaced.
+ */
+
+#include "audio_adpcm.h"
+
+#include "stm32u5xx_hal.h"
+#include "storage_task.h"
+
+#include <stddef.h>
+
+/* Stream bytes read per storage_stream_read(): one mix chunk of codes. */
+#define ADPCM_STREAM_READ_BYTES 64U
+
+static const int16_t kImaStepTable[89] =
+{
+  7, 8, 9, 10, 11, 12, 13, 14,
+  16, 17, 19, 21, 23, 25, 28, 31,
+  34, 37, 41, 45, 50, 55, 60, 66,
+  73, 80, 88, 97, 107, 118, 130, 143,
+  157, 173, 190, 209, 230, 253, 279, 307,
+  337, 371, 408, 449, 494, 544, 598, 658,
+  724, 796, 876, 963, 1060, 1166, 1282, 1411,
+  1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024,
+  3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484,
+  7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+  15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+  32767
+};
+
+static uint8_t s_read_bytes[ADPCM_STREAM_READ_BYTES];
+
+static uint16_t adpcm_read_u16_le(const uint8_t *data)
+{
+  return (uint16_t)data[0] | (uint16_t)((uint16_t)data[1] << 8);
+}
+
+void audio_adpcm_reset(adpcm_state_t *state)
+{
+  if (state == NULL)
+  {
+    return;
+  }
+
+  state->data_offset = 0U;
+  state->block_end = 0U;
+  state->byte_offset = 0U;
+  state->samples_left = 0U;
+  state->predictor = 0;
+  state->index = 0U;
+  state->nibble_high = 0U;
+}
+
+static uint8_t audio_adpcm_begin_block(const wav_info_t *wav, adpcm_state_t *state)
+{
+  if ((wav == NULL) || (state == NULL))
+  {
+    return 0U;
+  }
+
+  if ((state->data_offset + wav->block_align) > wav->data_bytes)
+  {
+    return 0U;
+  }
+
+  const uint8_t *block = &wav->data[state->data_offset];
+  state->predictor = (int16_t)adpcm_read_u16_le(block);
+  state->index = block[2];
+  if (state->index > 88U)
+  {
+    state->index = 88U;
+  }
+  state->byte_offset = state->data_offset + 4U;
+  state->block_end = state->data_offset + wav->block_align;
+  state->samples_left = wav->samples_per_block;
+  state->nibble_high = 0U;
+  state->data_offset = state->block_end;
+  return 1U;
+}
+
+/*
+ * One IMA-ADPCM nibble: advances predictor and step index, returns the
+ * sample. The index change is computed rather than looked up: codes 0-3
+ * step down by one, 4-7 step up by 2, 4, 6 or 8, and bit 3 is the sign.
+ */
+static inline int16_t audio_ima_decode_nibble(int32_t *predictor, int32_t *index, uint32_t code)
+{
+  const int32_t step = kImaStepTable[*index];
+  int32_t diff = step >> 3;
+  if ((code & 1U) != 0U)
+  {
+    diff += step >> 2;
+  }
+  if ((code & 2U) != 0U)
+  {
+    diff += step >> 1;
+  }
+  if ((code & 4U) != 0U)
+  {
+    diff += step;
+  }
+
+  int32_t p = ((code & 8U) != 0U) ? (*predictor - diff) : (*predictor + diff);
+  *predictor = __SSAT(p, 16);
+
+  int32_t i = *index + (((code & 4U) != 0U) ? (int32_t)(((code & 3U) + 1U) * 2U) : -1);
+  if (i < 0)
+  {
+    i = 0;
+  }
+  else if (i > 88)
+  {
+    i = 88;
+  }
+  *index = i;
+
+  return (int16_t)*predictor;
+}
+
+/* Decode `bytes` whole ADPCM bytes, low nibble first, into 2 * `bytes` samples. */
+static void audio_ima_decode_bytes(const uint8_t *src, uint32_t bytes, int16_t *dst,
+                                   int32_t *predictor, int32_t *index)
+{
+  int32_t p = *predictor;
+  int32_t i = *index;
+  for (uint32_t k = 0U; k < bytes; ++k)
+  {
+    const uint32_t b = src[k];
+    dst[0] = audio_ima_decode_nibble(&p, &i, b & 0x0FU);
+    dst[1] = audio_ima_decode_nibble(&p, &i, b >> 4);
+    dst += 2;
+  }
+  *predictor = p;
+  *index = i;
+}
+
+/*
+ * Decode one complete IMA block (header plus samples_per_block - 1 codes)
+ * into `dst`. Returns the samples written.
+ */
+static uint32_t audio_adpcm_decode_block(const wav_info_t *wav, const uint8_t *block, int16_t *dst)
+{
+  int32_t predictor = (int16_t)adpcm_read_u16_le(block);
+  int32_t index = (block[2] > 88U) ? 88 : (int32_t)block[2];
+  dst[0] = (int16_t)predictor;
+
+  uint32_t codes = (uint32_t)wav->samples_per_block - 1U;
+  const uint32_t max_codes = ((uint32_t)wav->block_align - 4U) * 2U;
+  if (codes > max_codes)
+  {
+    codes = max_codes;
+  }
+
+  const uint32_t bytes = codes / 2U;
+  audio_ima_decode_bytes(&block[4], bytes, &dst[1], &predictor, &index);
+  if ((codes & 1U) != 0U)
+  {
+    dst[codes] = audio_ima_decode_nibble(&predictor, &index, block[4U + bytes] & 0x0FU);
+  }
+  return codes + 1U;
+}
+
+/*
+ * Decode up to `count` samples into `dst`, crossing block boundaries as
+ * needed. Blocks that fit whole go through audio_adpcm_decode_block();
+ * partial ones are decoded a byte (two codes) at a time from where the
+ * last call stopped. Returns the samples written; fewer than `count` means
+ * the data ran out.
+ */
+uint32_t audio_adpcm_decode(const wav_info_t *wav, adpcm_state_t *state, int16_t *dst, uint32_t count)
+{
+  uint32_t produced = 0U;
+
+  while (produced < count)
+  {
+    if (state->samples_left == 0U)
+    {
+      if (((count - produced) >= wav->samples_per_block) &&
+          ((state->data_offset + wav->block_align) <= wav->data_bytes))
+      {
+        /* The whole block fits: decode it straight into the output. */
+        produced += audio_adpcm_decode_block(wav, &wav->data[state->data_offset], &dst[produced]);
+        state->data_offset += wav->block_align;
+        continue;
+      }
+      if (audio_adpcm_begin_block(wav, state) == 0U)
+      {
+        break;
+      }
+      /* The block header carries the first sample verbatim. */
+      state->samples_left--;
+      dst[produced++] = state->predictor;
+      continue;
+    }
+
+    if (state->byte_offset >= state->block_end)
+    {
+      state->samples_left = 0U;
+      continue;
+    }
+    uint32_t avail = ((state->block_end - state->byte_offset) * 2U) - state->nibble_high;
+
+    uint32_t n = count - produced;
+    if (n > state->samples_left)
+    {
+      n = state->samples_left;
+    }
+    if (n > avail)
+    {
+      n = avail;
+    }
+
+    const uint8_t *src = wav->data;
+    uint32_t byte_offset = state->byte_offset;
+    uint32_t left = n;
+    int32_t predictor = state->predictor;
+    int32_t index = state->index;
+    if (state->nibble_high != 0U)
+    {
+      dst[produced++] = audio_ima_decode_nibble(&predictor, &index, (uint32_t)src[byte_offset] >> 4);
+      byte_offset++;
+      left--;
+    }
+
+    const uint32_t bytes = left / 2U;
+    audio_ima_decode_bytes(&src[byte_offset], bytes, &dst[produced], &predictor, &index);
+    byte_offset += bytes;
+    produced += bytes * 2U;
+
+    uint8_t high = 0U;
+    if ((left & 1U) != 0U)
+    {
+      dst[produced++] = audio_ima_decode_nibble(&predictor, &index, src[byte_offset] & 0x0FU);
+      high = 1U;
+    }
+
+    state->byte_offset = byte_offset;
+    state->nibble_high = high;
+    state->predictor = (int16_t)predictor;
+    state->index = (uint8_t)index;
+    state->samples_left = (uint16_t)(state->samples_left - n);
+  }
+
+  return produced;
+}
+
+void audio_adpcm_stream_reset(adpcm_stream_state_t *state)
+{
+  if (state == NULL)
+  {
+    return;
+  }
+
+  state->samples_left = 0U;
+  state->block_bytes_left = 0U;
+  state->predictor = 0;
+  state->index = 0U;
+  state->nibble_high = 0U;
+  state->cur_byte = 0U;
+}
+
+/*
+ * Decode up to `count` streamed samples into `dst`. Block bytes are pulled
+ * from the storage ring in runs rather than one at a time.
+ */
+uint32_t audio_adpcm_stream_decode(adpcm_stream_state_t *state, const wav_info_t *wav, uint32_t *bytes_left,
+                                   int16_t *dst, uint32_t count, uint8_t *done)
+{
+  uint32_t produced = 0U;
+  *done = 0U;
+
+  while (produced < count)
+  {
+    if (state->samples_left == 0U)
+    {
+      if (*bytes_left < wav->block_align)
+      {
+        *done = 1U;
+        break;
+      }
+
+      if (storage_stream_available() < 4U)
+      {
+        break;
+      }
+
+      uint8_t header[4];
+      if (storage_stream_read(header, (uint32_t)sizeof(header)) != (uint32_t)sizeof(header))
+      {
+        break;
+      }
+
+      state->predictor = (int16_t)((uint16_t)header[0] | ((uint16_t)header[1] << 8));
+      state->index = header[2];
+      if (state->index > 88U)
+      {
+        state->index = 88U;
+      }
+      state->samples_left = wav->samples_per_block;
+      state->block_bytes_left = (uint16_t)(wav->block_align - 4U);
+      state->nibble_high = 0U;
+      state->cur_byte = 0U;
+      *bytes_left -= wav->block_align;
+
+      state->samples_left--;
+      dst[produced++] = state->predictor;
+      continue;
+    }
+
+    if ((state->block_bytes_left == 0U) && (state->nibble_high == 0U))
+    {
+      state->samples_left = 0U;
+      continue;
+    }
+
+    uint32_t want = count - produced;
+    if (want > state->samples_left)
+    {
+      want = state->samples_left;
+    }
+
+    const uint32_t start = produced;
+    int32_t predictor = state->predictor;
+    int32_t index = state->index;
+
+    /* Finish a byte whose low nibble went out with the previous chunk. */
+    if (state->nibble_high != 0U)
+    {
+      dst[produced++] = audio_ima_decode_nibble(&predictor, &index, (uint32_t)state->cur_byte >> 4);
+      state->nibble_high = 0U;
+      want--;
+    }
+
+    uint32_t got = 0U;
+    if (want > 0U)
+    {
+      uint32_t bytes = (want + 1U) / 2U;
+      if (bytes > state->block_bytes_left)
+      {
+        bytes = state->block_bytes_left;
+      }
+      if (bytes > (uint32_t)sizeof(s_read_bytes))
+      {
+        bytes = (uint32_t)sizeof(s_read_bytes);
+      }
+      got = storage_stream_read(s_read_bytes, bytes);
+      state->block_bytes_left = (uint16_t)(state->block_bytes_left - got);
+    }
+
+    /* With an odd count the last byte read only gives up its low nibble. */
+    const uint32_t whole = ((got * 2U) > want) ? (got - 1U) : got;
+    audio_ima_decode_bytes(s_read_bytes, whole, &dst[produced], &predictor, &index);
+    produced += whole * 2U;
+    want -= whole * 2U;
+    if (whole < got)
+    {
+      state->cur_byte = s_read_bytes[whole];
+      dst[produced++] = audio_ima_decode_nibble(&predictor, &index, state->cur_byte & 0x0FU);
+      state->nibble_high = 1U;
+      want = 0U;
+    }
+
+    state->predictor = (int16_t)predictor;
+    state->index = (uint8_t)index;
+    state->samples_left = (uint16_t)(state->samples_left - (produced - start));
+
+    if (produced == start)
+    {
+      break;
+    }
+    if ((want > 0U) && (got == 0U) && (state->block_bytes_left > 0U))
+    {
+      /* Underrun: the storage ring has no more bytes for now. */
+      break;
+    }
+  }
+
+  return produced;
+}
@@ -1,12 +1,14 @@
 #include "audio_task.h"
 
 #include "app_freertos.h"
+#include "audio_adpcm.h"
 #include "cmsis_os2.h"
 #include "main.h"
 #include "sound_manager.h"
 #include "storage_task.h"
 #include "power_task.h"
 
+#include <string.h>
 
 extern SAI_HandleTypeDef hsai_BlockA1;
 
@@ -18,43 +20,20 @@ typedef enum
 
 typedef enum
 {
-  WAV_FORMAT_PCM = 1U,
-  WAV_FORMAT_IMA_ADPCM = 0x11U
-} wav_format_t;
+  AUDIO_PCM_EMPTY = 0,
+  AUDIO_PCM_FILLING = 1,  /* A voice is decoding into it as it plays */
+  AUDIO_PCM_READY = 2
+} audio_pcm_state_t;
 
+/* A decoded sound in s_pcm_arena; offset and samples are in samples. */
 typedef struct
 {
-  const uint8_t *data;
-  uint32_t data_bytes;
-  uint32_t sample_rate;
-  wav_format_t format;
-  uint32_t total_frames;
-  uint16_t channels;
-  uint16_t bits_per_sample;
-  uint16_t block_align;
-  uint16_t samples_per_block;
-} wav_info_t;
-
-typedef struct
-{
-  uint32_t data_offset;
-  uint32_t block_end;
-  uint32_t byte_offset;
-  uint16_t samples_left;
-  int16_t predictor;
-  uint8_t index;
-  uint8_t nibble_high;
-} adpcm_state_t;
-
-typedef struct
-{
-  uint16_t samples_left;
-  uint16_t block_bytes_left;
-  int16_t predictor;
-  uint8_t index;
-  uint8_t nibble_high;
-  uint8_t cur_byte;
-} adpcm_stream_state_t;
+  uint32_t offset;
+  uint32_t samples;
+  uint32_t last_use;
+  audio_pcm_state_t state;
+  uint8_t stale;  /* The ADPCM was reloaded while a voice used this copy */
+} audio_pcm_entry_t;
 
 typedef struct
 {
@@ -66,6 +45,11 @@ typedef struct
   uint8_t gain_q8;
   wav_info_t wav;
   adpcm_state_t adpcm;
+  audio_pcm_entry_t *pcm;  /* Decoded copy being played or filled, if any */
+  uint32_t pcm_pos;
+  uint8_t pcm_fill;
+  uint8_t lat_pending;     /* Started by a timed play; not mixed yet */
+  uint32_t lat_enqueue_ms; /* That play's sound_play() time */
 } audio_voice_t;
 
 static const uint32_t kAudioFlagHalf = (1UL << 0U);
@@ -73,6 +57,12 @@ static const uint32_t kAudioFlagFull = (1UL << 1U);
 static const uint32_t kAudioFlagError = (1UL << 2U);
 
 #define AUDIO_MAX_SFX_VOICES 5U
+#define AUDIO_MIX_CHUNK_FRAMES 128U  /* Frames decoded per source per mix pass */
+#define AUDIO_PERIOD_FRAMES_MAX 512U /* Largest period; sizes s_audio_buf */
+/* Decoded PCM for SOUND_F_PCM_CACHE sounds: 96 KB holds two 1.4 s UI sounds. */
+#ifndef AUDIO_PCM_CACHE_SAMPLES
+#define AUDIO_PCM_CACHE_SAMPLES (48U * 1024U)
+#endif
 
 static const uint32_t kAudioSampleRate = 16000U;
 static const uint8_t kAudioVolumeMax = 20U;
@@ -80,30 +70,14 @@ static const uint8_t kAudioVolumeDefault = 7U;
 static const uint32_t kAudioStreamPrebufferMin = 512U;
 static const uint32_t kAudioStreamPrebufferMax = 2048U;
 static const uint32_t kAudioStreamRetryMaxTries = 100U;
-
-static const int16_t kImaStepTable[89] =
-{
-  7, 8, 9, 10, 11, 12, 13, 14,
-  16, 17, 19, 21, 23, 25, 28, 31,
-  34, 37, 41, 45, 50, 55, 60, 66,
-  73, 80, 88, 97, 107, 118, 130, 143,
-  157, 173, 190, 209, 230, 253, 279, 307,
-  337, 371, 408, 449, 494, 544, 598, 658,
-  724, 796, 876, 963, 1060, 1166, 1282, 1411,
-  1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024,
-  3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484,
-  7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
-  15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
-  32767
-};
-
-static const int8_t kImaIndexTable[16] =
-{
-  -1, -1, -1, -1, 2, 4, 6, 8,
-  -1, -1, -1, -1, 2, 4, 6, 8
-};
-
-static int16_t s_audio_buf[2048];
+/* Period (half-buffer) size by use case; shorter is heard sooner, longer refills less often. */
+static const uint32_t kAudioPeriodUi = 128U;      /* 8 ms: menu clicks */
+static const uint32_t kAudioPeriodGame = 256U;    /* 16 ms: SFX while tskDisplay renders */
+static const uint32_t kAudioPeriodStream = 512U;  /* 32 ms: music streamed from littlefs */
+
+/* One 16-bit word per frame: the SAI runs in mono mode and repeats it in both slots. */
+static int16_t s_audio_buf[2U * AUDIO_PERIOD_FRAMES_MAX];
+static uint32_t s_audio_period = AUDIO_PERIOD_FRAMES_MAX;
 static audio_state_t s_audio_state = AUDIO_STATE_IDLE;
 static audio_voice_t s_sfx_voices[AUDIO_MAX_SFX_VOICES];
 static wav_info_t s_stream_wav;
@@ -120,12 +94,39 @@ static uint8_t s_stream_retry = 0U;
 static sound_id_t s_stream_retry_id = SND_COUNT;
 static sound_flags_t s_stream_retry_flags = 0U;
 static uint32_t s_stream_retry_tries = 0U;
+static uint8_t s_stream_lat_pending = 0U;
+static uint32_t s_stream_lat_ms = 0U;
+static uint8_t s_stream_retry_lat_pending = 0U;
+static uint32_t s_stream_retry_lat_ms = 0U;
 static volatile uint8_t s_audio_volume = kAudioVolumeDefault;
 static uint8_t s_category_volume[SOUND_CAT_COUNT] = {5U, 5U, 5U};
 static uint8_t s_audio_power_ref = 0U;
 static uint8_t s_audio_dma_circular = 0U;
 static DMA_QListTypeDef s_audio_dma_queue;
 static DMA_NodeTypeDef s_audio_dma_node;
+/* Block mixer scratch: one source's decoded chunk and the running sum. */
+static int16_t s_mix_src[AUDIO_MIX_CHUNK_FRAMES];
+static int32_t s_mix_acc[AUDIO_MIX_CHUNK_FRAMES];
+static int16_t s_pcm_arena[AUDIO_PCM_CACHE_SAMPLES];
+static audio_pcm_entry_t s_pcm_entries[SND_COUNT];
+static uint32_t s_pcm_clock = 0U;
+/*
+ * Play latency: sound_play_ex() stamps a slot and puts its tag in the
+ * command (SOUND_CMD_LAT_*). audio_handle_play() reads the stamp into
+ * s_lat_request, the source it starts takes it over, and the first mix pass
+ * that gets samples from that source arms the measurement for its half.
+ * One measurement is in flight at a time; others started meanwhile are not
+ * counted. A slot is reused after AUDIO_LAT_SLOTS - 1 requests.
+ */
+#define AUDIO_LAT_SLOTS (SOUND_CMD_LAT_MASK + 1U)
+static volatile uint32_t s_lat_slot_ms[AUDIO_LAT_SLOTS];
+static uint8_t s_lat_next_tag = 1U;
+static uint8_t s_lat_request = 0U;       /* Only set inside audio_handle_play() */
+static uint32_t s_lat_request_ms = 0U;
+static uint8_t s_lat_armed = 0U;
+static uint32_t s_lat_armed_ms = 0U;
+static uint8_t s_lat_half = 0U;
+static audio_latency_stats_t s_lat_stats;
 
 static uint8_t audio_volume_to_q8(uint8_t level)
 {
@@ -384,285 +385,6 @@ static uint8_t audio_stream_prepare(const storage_stream_info_t *info)
   return 1U;
 }
 
-static void audio_adpcm_reset(adpcm_state_t *state)
-{
-  if (state == NULL)
-  {
-    return;
-  }
-
-  state->data_offset = 0U;
-  state->block_end = 0U;
-  state->byte_offset = 0U;
-  state->samples_left = 0U;
-  state->predictor = 0;
-  state->index = 0U;
-  state->nibble_high = 0U;
-}
-
-static uint8_t audio_adpcm_begin_block(const wav_info_t *wav, adpcm_state_t *state)
-{
-  if ((wav == NULL) || (state == NULL))
-  {
-    return 0U;
-  }
-
-  if ((state->data_offset + wav->block_align) > wav->data_bytes)
-  {
-    return 0U;
-  }
-
-  const uint8_t *block = &wav->data[state->data_offset];
-  state->predictor = (int16_t)audio_read_u16_le(block);
-  state->index = block[2];
-  if (state->index > 88U)
-  {
-    state->index = 88U;
-  }
-  state->byte_offset = state->data_offset + 4U;
-  state->block_end = state->data_offset + wav->block_align;
-  state->samples_left = wav->samples_per_block;
-  state->nibble_high = 0U;
-  state->data_offset = state->block_end;
-  return 1U;
-}
-
-static uint8_t audio_adpcm_next_sample(const wav_info_t *wav, adpcm_state_t *state, int16_t *out)
-{
-  if ((wav == NULL) || (state == NULL) || (out == NULL))
-  {
-    return 0U;
-  }
-
-  if (state->samples_left == 0U)
-  {
-    if (audio_adpcm_begin_block(wav, state) == 0U)
-    {
-      return 0U;
-    }
-  }
-
-  if (state->samples_left == wav->samples_per_block)
-  {
-    state->samples_left--;
-    *out = state->predictor;
-    return 1U;
-  }
-
-  if (state->byte_offset >= state->block_end)
-  {
-    state->samples_left = 0U;
-    return 0U;
-  }
-
-  uint8_t code;
-  if (state->nibble_high == 0U)
-  {
-    code = wav->data[state->byte_offset] & 0x0FU;
-    state->nibble_high = 1U;
-  }
-  else
-  {
-    code = (wav->data[state->byte_offset] >> 4) & 0x0FU;
-    state->nibble_high = 0U;
-    state->byte_offset++;
-  }
-
-  int32_t predictor = state->predictor;
-  int32_t step = kImaStepTable[state->index];
-  int32_t diff = step >> 3;
-  if ((code & 1U) != 0U)
-  {
-    diff += step >> 2;
-  }
-  if ((code & 2U) != 0U)
-  {
-    diff += step >> 1;
-  }
-  if ((code & 4U) != 0U)
-  {
-    diff += step;
-  }
-  if ((code & 8U) != 0U)
-  {
-    predictor -= diff;
-  }
-  else
-  {
-    predictor += diff;
-  }
-
-  if (predictor > 32767)
-  {
-    predictor = 32767;
-  }
-  else if (predictor < -32768)
-  {
-    predictor = -32768;
-  }
-
-  state->predictor = (int16_t)predictor;
-
-  int32_t index = (int32_t)state->index + (int32_t)kImaIndexTable[code];
-  if (index < 0)
-  {
-    index = 0;
-  }
-  else if (index > 88)
-  {
-    index = 88;
-  }
-  state->index = (uint8_t)index;
-
-  state->samples_left--;
-  *out = state->predictor;
-  return 1U;
-}
-
-static void audio_adpcm_stream_reset(adpcm_stream_state_t *state)
-{
-  if (state == NULL)
-  {
-    return;
-  }
-
-  state->samples_left = 0U;
-  state->block_bytes_left = 0U;
-  state->predictor = 0;
-  state->index = 0U;
-  state->nibble_high = 0U;
-  state->cur_byte = 0U;
-}
-
-static uint8_t audio_adpcm_stream_next_sample(adpcm_stream_state_t *state, int16_t *out, uint8_t *done)
-{
-  if ((state == NULL) || (out == NULL))
-  {
-    return 0U;
-  }
-
-  if (done != NULL)
-  {
-    *done = 0U;
-  }
-
-  if (state->samples_left == 0U)
-  {
-    if (s_stream_bytes_left < s_stream_wav.block_align)
-    {
-      if (done != NULL)
-      {
-        *done = 1U;
-      }
-      return 0U;
-    }
-
-    if (storage_stream_available() < 4U)
-    {
-      return 0U;
-    }
-
-    uint8_t header[4];
-    if (storage_stream_read(header, (uint32_t)sizeof(header)) != (uint32_t)sizeof(header))
-    {
-      return 0U;
-    }
-
-    state->predictor = (int16_t)((uint16_t)header[0] | ((uint16_t)header[1] << 8));
-    state->index = header[2];
-    if (state->index > 88U)
-    {
-      state->index = 88U;
-    }
-    state->samples_left = s_stream_wav.samples_per_block;
-    state->block_bytes_left = (uint16_t)(s_stream_wav.block_align - 4U);
-    state->nibble_high = 0U;
-    state->cur_byte = 0U;
-    s_stream_bytes_left -= s_stream_wav.block_align;
-
-    state->samples_left--;
-    *out = state->predictor;
-    return 1U;
-  }
-
-  if (state->block_bytes_left == 0U)
-  {
-    state->samples_left = 0U;
-    return 0U;
-  }
-
-  uint8_t code;
-  if (state->nibble_high == 0U)
-  {
-    if (storage_stream_available() < 1U)
-    {
-      return 0U;
-    }
-    if (storage_stream_read(&state->cur_byte, 1U) != 1U)
-    {
-      return 0U;
-    }
-    state->block_bytes_left--;
-    code = state->cur_byte & 0x0FU;
-    state->nibble_high = 1U;
-  }
-  else
-  {
-    code = (state->cur_byte >> 4) & 0x0FU;
-    state->nibble_high = 0U;
-  }
-
-  int32_t predictor = state->predictor;
-  int32_t step = kImaStepTable[state->index];
-  int32_t diff = step >> 3;
-  if ((code & 1U) != 0U)
-  {
-    diff += step >> 2;
-  }
-  if ((code & 2U) != 0U)
-  {
-    diff += step >> 1;
-  }
-  if ((code & 4U) != 0U)
-  {
-    diff += step;
-  }
-  if ((code & 8U) != 0U)
-  {
-    predictor -= diff;
-  }
-  else
-  {
-    predictor += diff;
-  }
-
-  if (predictor > 32767)
-  {
-    predictor = 32767;
-  }
-  else if (predictor < -32768)
-  {
-    predictor = -32768;
-  }
-
-  state->predictor = (int16_t)predictor;
-
-  int32_t index = (int32_t)state->index + (int32_t)kImaIndexTable[code];
-  if (index < 0)
-  {
-    index = 0;
-  }
-  else if (index > 88)
-  {
-    index = 88;
-  }
-  state->index = (uint8_t)index;
-
-  state->samples_left--;
-  *out = state->predictor;
-  return 1U;
-}
-
 static int16_t audio_wav_sample(const wav_info_t *wav, uint32_t frame)
 {
   uint32_t offset = frame * (uint32_t)wav->block_align;
@@ -691,21 +413,59 @@ static int16_t audio_wav_sample(const wav_info_t *wav, uint32_t frame)
   return (int16_t)(((int32_t)l + (int32_t)r) / 2);
 }
 
-static int16_t audio_apply_volume(int32_t sample)
+/* Hand the play request being handled to the source it starts. */
+static void audio_latency_take(uint8_t *pending, uint32_t *enqueue_ms)
+{
+  *pending = s_lat_request;
+  *enqueue_ms = s_lat_request_ms;
+  s_lat_request = 0U;
+}
+
+/* A source started by a timed play just got its first samples into buffer half `half`. */
+static void audio_latency_mixed(uint32_t enqueue_ms, uint8_t half)
+{
+  if (s_lat_armed == 0U)
+  {
+    s_lat_armed = 1U;
+    s_lat_armed_ms = enqueue_ms;
+    s_lat_half = half;
+  }
+}
+
+/* Called as the DMA starts reading buffer half `half`. */
+static void audio_latency_half_playing(uint8_t half)
 {
-  int32_t level = (int32_t)s_audio_volume;
-  int32_t scaled = (sample * (level * 5)) / (int32_t)kAudioVolumeMax;
+  if ((s_lat_armed == 0U) || (s_lat_half != half))
+  {
+    return;
+  }
 
-  if (scaled > 32767)
+  uint32_t latency = osKernelGetTickCount() - s_lat_armed_ms;
+  s_lat_stats.last_ms = latency;
+  if (latency > s_lat_stats.max_ms)
   {
-    return 32767;
+    s_lat_stats.max_ms = latency;
   }
-  if (scaled < -32768)
+  s_lat_stats.count++;
+  s_lat_armed = 0U;
+}
+
+static uint32_t audio_select_period(void)
+{
+  if ((s_stream_active != 0U) || (s_stream_wait != 0U))
   {
-    return -32768;
+    return kAudioPeriodStream;
   }
 
-  return (int16_t)scaled;
+  if (egModeHandle != NULL)
+  {
+    uint32_t flags = osEventFlagsGet(egModeHandle);
+    if (((int32_t)flags >= 0) && ((flags & APP_MODE_GAME) != 0U))
+    {
+      return kAudioPeriodGame;
+    }
+  }
+  return kAudioPeriodUi;
 }
 
 static void audio_request_power_on(void)
@@ -856,44 +616,263 @@ static uint8_t audio_has_pending(void)
   return ((audio_has_output() != 0U) || (s_stream_wait != 0U)) ? 1U : 0U;
 }
 
-static void audio_stop_all_sfx(void)
+/* ----------------------- Decoded PCM cache tier -------------------------- */
+
+static uint8_t audio_pcm_in_use(const audio_pcm_entry_t *entry)
 {
   for (uint32_t i = 0U; i < AUDIO_MAX_SFX_VOICES; ++i)
   {
-    s_sfx_voices[i].active = 0U;
+    if ((s_sfx_voices[i].active != 0U) && (s_sfx_voices[i].pcm == entry))
+    {
+      return 1U;
+    }
   }
+  return 0U;
 }
 
-static int32_t audio_scale_sample(int16_t sample, uint8_t gain_q8)
+/* First-fit gap of `samples` in the arena, between the live entries. */
+static uint8_t audio_pcm_find_gap(uint32_t samples, uint32_t *offset)
 {
-  return ((int32_t)sample * (int32_t)gain_q8) >> 8;
+  for (uint32_t c = 0U; c <= (uint32_t)SND_COUNT; ++c)
+  {
+    uint32_t start = 0U;
+    if (c > 0U)
+    {
+      const audio_pcm_entry_t *base = &s_pcm_entries[c - 1U];
+      if (base->state == AUDIO_PCM_EMPTY)
+      {
+        continue;
+      }
+      start = base->offset + base->samples;
+    }
+    if ((start + samples) > AUDIO_PCM_CACHE_SAMPLES)
+    {
+      continue;
+    }
+
+    uint8_t fits = 1U;
+    for (uint32_t i = 0U; i < (uint32_t)SND_COUNT; ++i)
+    {
+      const audio_pcm_entry_t *e = &s_pcm_entries[i];
+      if ((e->state != AUDIO_PCM_EMPTY) &&
+          (e->offset < (start + samples)) && (start < (e->offset + e->samples)))
+      {
+        fits = 0U;
+        break;
+      }
+    }
+    if (fits != 0U)
+    {
+      *offset = start;
+      return 1U;
+    }
+  }
+  return 0U;
 }
 
-static uint8_t audio_voice_next_sample(audio_voice_t *voice, int16_t *out)
+/* Reserve arena space for `entry`, evicting idle entries least recently played first. */
+static uint8_t audio_pcm_alloc(audio_pcm_entry_t *entry, uint32_t samples)
 {
-  if ((voice == NULL) || (out == NULL) || (voice->active == 0U))
+  if ((samples == 0U) || (samples > AUDIO_PCM_CACHE_SAMPLES))
   {
     return 0U;
   }
 
-  if (audio_adpcm_next_sample(&voice->wav, &voice->adpcm, out) != 0U)
+  for (;;)
   {
-    return 1U;
+    uint32_t offset = 0U;
+    if (audio_pcm_find_gap(samples, &offset) != 0U)
+    {
+      entry->offset = offset;
+      entry->samples = samples;
+      entry->last_use = s_pcm_clock;
+      return 1U;
+    }
+
+    audio_pcm_entry_t *victim = NULL;
+    for (uint32_t i = 0U; i < (uint32_t)SND_COUNT; ++i)
+    {
+      audio_pcm_entry_t *e = &s_pcm_entries[i];
+      if ((e->state != AUDIO_PCM_READY) || (audio_pcm_in_use(e) != 0U))
+      {
+        continue;
+      }
+      if ((victim == NULL) || ((int32_t)(e->last_use - victim->last_use) < 0))
+      {
+        victim = e;
+      }
+    }
+    if (victim == NULL)
+    {
+      return 0U;
+    }
+    victim->state = AUDIO_PCM_EMPTY;
   }
+}
 
-  if ((voice->flags & SOUND_F_LOOP) != 0U)
+/*
+ * Hook a starting voice up to its PCM entry: a ready entry is played as is;
+ * an empty one is allocated and filled by this voice as it decodes.
+ */
+static void audio_pcm_attach(audio_voice_t *voice)
+{
+  if ((uint32_t)voice->id >= (uint32_t)SND_COUNT)
   {
-    audio_adpcm_reset(&voice->adpcm);
-    if (audio_adpcm_next_sample(&voice->wav, &voice->adpcm, out) != 0U)
+    return;
+  }
+
+  audio_pcm_entry_t *entry = &s_pcm_entries[voice->id];
+  if (entry->stale != 0U)
+  {
+    /* Decoded from the old ADPCM; play the new data uncached until it is dropped. */
+    return;
+  }
+  if (entry->state == AUDIO_PCM_READY)
+  {
+    entry->last_use = ++s_pcm_clock;
+    voice->pcm = entry;
+    return;
+  }
+
+  if ((entry->state == AUDIO_PCM_EMPTY) && (audio_pcm_alloc(entry, voice->wav.total_frames) != 0U))
+  {
+    entry->state = AUDIO_PCM_FILLING;
+    entry->last_use = ++s_pcm_clock;
+    voice->pcm = entry;
+    voice->pcm_fill = 1U;
+  }
+}
+
+static void audio_voice_stop(audio_voice_t *voice)
+{
+  audio_pcm_entry_t *entry = voice->pcm;
+  if (voice->pcm_fill != 0U)
+  {
+    /* A fill cut short would leave a hole in the sound; drop it. */
+    entry->state = AUDIO_PCM_EMPTY;
+  }
+  voice->pcm = NULL;
+  voice->pcm_fill = 0U;
+  voice->active = 0U;
+  voice->lat_pending = 0U;
+
+  if ((entry != NULL) && (entry->stale != 0U) && (audio_pcm_in_use(entry) == 0U))
+  {
+    entry->state = AUDIO_PCM_EMPTY;
+    entry->stale = 0U;
+  }
+}
+
+static void audio_stop_all_sfx(void)
+{
+  for (uint32_t i = 0U; i < AUDIO_MAX_SFX_VOICES; ++i)
+  {
+    audio_voice_stop(&s_sfx_voices[i]);
+  }
+}
+
+static void audio_mix_accumulate(int32_t *acc, const int16_t *src, uint32_t count, uint8_t gain_q8)
+{
+  const int32_t gain = (int32_t)gain_q8;
+  for (uint32_t i = 0U; i < count; ++i)
+  {
+    acc[i] += ((int32_t)src[i] * gain) >> 8;
+  }
+}
+
+/*
+ * Mix up to `count` samples of a voice into `acc`, wrapping looped voices.
+ * A cached voice is summed straight from the arena; one filling its entry
+ * decodes into the arena; the rest decode into s_mix_src. Returns the
+ * samples mixed.
+ */
+static uint32_t audio_voice_mix(audio_voice_t *voice, int32_t *acc, uint32_t count)
+{
+  uint32_t produced = 0U;
+  uint8_t restarted = 0U;
+
+  while (produced < count)
+  {
+    uint32_t want = count - produced;
+    const int16_t *src = s_mix_src;
+    uint32_t n;
+
+    if ((voice->pcm != NULL) && (voice->pcm->state == AUDIO_PCM_READY))
     {
-      return 1U;
+      const uint32_t left = voice->pcm->samples - voice->pcm_pos;
+      n = (want < left) ? want : left;
+      src = &s_pcm_arena[voice->pcm->offset + voice->pcm_pos];
+      voice->pcm_pos += n;
+    }
+    else if (voice->pcm_fill != 0U)
+    {
+      const uint32_t left = voice->pcm->samples - voice->pcm_pos;
+      int16_t *dst = &s_pcm_arena[voice->pcm->offset + voice->pcm_pos];
+      n = audio_adpcm_decode(&voice->wav, &voice->adpcm, dst, (want < left) ? want : left);
+      src = dst;
+      voice->pcm_pos += n;
+      if ((n < want) || (voice->pcm_pos >= voice->pcm->samples))
+      {
+        /* Fully decoded, possibly shorter than the header promised. */
+        voice->pcm->samples = voice->pcm_pos;
+        voice->pcm->state = AUDIO_PCM_READY;
+        voice->pcm_fill = 0U;
+      }
+    }
+    else
+    {
+      n = audio_adpcm_decode(&voice->wav, &voice->adpcm, s_mix_src, want);
     }
+
+    audio_mix_accumulate(&acc[produced], src, n, voice->gain_q8);
+    produced += n;
+    if (n != 0U)
+    {
+      restarted = 0U;
+    }
+    if (n == want)
+    {
+      continue;
+    }
+
+    /* The sound ran out within this chunk; a loop that yields nothing stops. */
+    if (((voice->flags & SOUND_F_LOOP) == 0U) || ((n == 0U) && (restarted != 0U)))
+    {
+      audio_voice_stop(voice);
+      break;
+    }
+    audio_adpcm_reset(&voice->adpcm);
+    voice->pcm_pos = 0U;
+    restarted = 1U;
   }
 
-  voice->active = 0U;
-  return 0U;
+  return produced;
+}
+
+/* Master volume and saturation, one output word per frame. */
+static void audio_mix_store(int16_t *dst, const int32_t *acc, uint32_t frames)
+{
+  const int32_t level = (int32_t)s_audio_volume * 5;
+  for (uint32_t i = 0U; i < frames; ++i)
+  {
+    int32_t scaled = (acc[i] * level) / (int32_t)kAudioVolumeMax;
+    if (scaled > 32767)
+    {
+      scaled = 32767;
+    }
+    else if (scaled < -32768)
+    {
+      scaled = -32768;
+    }
+    dst[i] = (int16_t)scaled;
+  }
 }
 
+/*
+ * Block mixer: the output is built AUDIO_MIX_CHUNK_FRAMES at a time. Each
+ * source decodes a whole chunk into s_mix_src, which is gain-scaled into
+ * s_mix_acc; the accumulator is then volume-scaled and saturated once.
+ */
 static void audio_mix_fill(int16_t *dst, uint32_t count)
 {
   if ((dst == NULL) || (count == 0U))
@@ -903,27 +882,29 @@ static void audio_mix_fill(int16_t *dst, uint32_t count)
 
   if (audio_has_output() == 0U)
   {
-    for (uint32_t i = 0U; i < count; ++i)
-    {
-      dst[i] = 0;
-    }
+    memset(dst, 0, count * sizeof(dst[0]));
     return;
   }
 
-  uint32_t frames = count / 2U;
-  for (uint32_t i = 0U; i < frames; ++i)
+  /* A source mixes from its start, so its first samples are in this half. */
+  const uint8_t half = (dst == s_audio_buf) ? 0U : 1U;
+  while (count > 0U)
   {
-    int32_t mix = 0;
+    uint32_t n = (count > AUDIO_MIX_CHUNK_FRAMES) ? AUDIO_MIX_CHUNK_FRAMES : count;
+    memset(s_mix_acc, 0, n * sizeof(s_mix_acc[0]));
 
     if (s_stream_active != 0U)
     {
-      int16_t pcm = 0;
       uint8_t done = 0U;
-      if (audio_adpcm_stream_next_sample(&s_stream_adpcm, &pcm, &done) != 0U)
+      uint32_t got = audio_adpcm_stream_decode(&s_stream_adpcm, &s_stream_wav, &s_stream_bytes_left,
+                                               s_mix_src, n, &done);
+      audio_mix_accumulate(s_mix_acc, s_mix_src, got, s_stream_gain_q8);
+      if ((got != 0U) && (s_stream_lat_pending != 0U))
       {
-        mix += audio_scale_sample(pcm, s_stream_gain_q8);
+        s_stream_lat_pending = 0U;
+        audio_latency_mixed(s_stream_lat_ms, half);
       }
-      else if (done != 0U)
+      if (done != 0U)
       {
         s_stream_done = 1U;
         s_stream_active = 0U;
@@ -937,16 +918,19 @@ static void audio_mix_fill(int16_t *dst, uint32_t count)
         continue;
       }
 
-      int16_t pcm = 0;
-      if (audio_voice_next_sample(&s_sfx_voices[v], &pcm) != 0U)
+      /* Read first: a sound shorter than the chunk stops inside the mix. */
+      audio_voice_t *voice = &s_sfx_voices[v];
+      const uint8_t lat_pending = voice->lat_pending;
+      if ((audio_voice_mix(voice, s_mix_acc, n) != 0U) && (lat_pending != 0U))
       {
-        mix += audio_scale_sample(pcm, s_sfx_voices[v].gain_q8);
+        voice->lat_pending = 0U;
+        audio_latency_mixed(voice->lat_enqueue_ms, half);
       }
     }
 
-    int16_t out = audio_apply_volume(mix);
-    dst[i * 2U] = out;
-    dst[i * 2U + 1U] = out;
+    audio_mix_store(dst, s_mix_acc, n);
+    dst += n;
+    count -= n;
   }
 }
 
@@ -957,7 +941,10 @@ static void audio_hw_start(void)
     return;
   }
 
-  audio_mix_fill(s_audio_buf, (uint32_t)(sizeof(s_audio_buf) / sizeof(s_audio_buf[0])));
+  /* The period is fixed for the whole run; it is chosen again on the next start. */
+  s_audio_period = audio_select_period();
+  s_lat_stats.period_frames = (uint16_t)s_audio_period;
+  audio_mix_fill(s_audio_buf, s_audio_period * 2U);
 
   (void)osThreadFlagsClear(kAudioFlagHalf | kAudioFlagFull | kAudioFlagError);
   (void)audio_configure_dma_circular();
@@ -965,9 +952,10 @@ static void audio_hw_start(void)
   HAL_GPIO_WritePin(SD_MODE_GPIO_Port, SD_MODE_Pin, GPIO_PIN_SET);
 
   if (HAL_SAI_Transmit_DMA(&hsai_BlockA1, (uint8_t *)s_audio_buf,
-                           (uint16_t)(sizeof(s_audio_buf) / sizeof(s_audio_buf[0]))) == HAL_OK)
+                           (uint16_t)(s_audio_period * 2U)) == HAL_OK)
   {
     s_audio_state = AUDIO_STATE_PLAYING;
+    audio_latency_half_playing(0U);
   }
   else
   {
@@ -986,6 +974,8 @@ static void audio_hw_stop(void)
   (void)HAL_SAI_DMAStop(&hsai_BlockA1);
   HAL_GPIO_WritePin(SD_MODE_GPIO_Port, SD_MODE_Pin, GPIO_PIN_RESET);
   s_audio_state = AUDIO_STATE_IDLE;
+  /* The armed half will not play. */
+  s_lat_armed = 0U;
   audio_request_power_off();
 }
 
@@ -1009,6 +999,7 @@ static void audio_stream_retry_clear(void)
   s_stream_retry_id = SND_COUNT;
   s_stream_retry_flags = 0U;
   s_stream_retry_tries = 0U;
+  s_stream_retry_lat_pending = 0U;
 }
 
 static void audio_stream_retry_set(sound_id_t id, sound_flags_t flags)
@@ -1017,6 +1008,7 @@ static void audio_stream_retry_set(sound_id_t id, sound_flags_t flags)
   s_stream_retry_id = id;
   s_stream_retry_flags = flags;
   s_stream_retry_tries = 0U;
+  audio_latency_take(&s_stream_retry_lat_pending, &s_stream_retry_lat_ms);
 }
 
 static uint8_t audio_stream_retry_try_open(void)
@@ -1054,6 +1046,9 @@ static uint8_t audio_stream_retry_try_open(void)
   s_stream_bytes_left = 0U;
   s_stream_prebuffer = 0U;
   audio_adpcm_stream_reset(&s_stream_adpcm);
+  /* Still timed from the play that asked for it. */
+  s_stream_lat_pending = s_stream_retry_lat_pending;
+  s_stream_lat_ms = s_stream_retry_lat_ms;
   audio_stream_retry_clear();
   return 1U;
 }
@@ -1074,6 +1069,7 @@ static void audio_stream_stop(void)
   s_stream_id = SND_COUNT;
   s_stream_flags = 0U;
   s_stream_gain_q8 = 0U;
+  s_stream_lat_pending = 0U;
   audio_stream_retry_clear();
   audio_adpcm_stream_reset(&s_stream_adpcm);
 
@@ -1125,6 +1121,7 @@ static void audio_stream_start(const sound_registry_entry_t *entry, sound_flags_
   s_stream_bytes_left = 0U;
   s_stream_prebuffer = 0U;
   audio_adpcm_stream_reset(&s_stream_adpcm);
+  audio_latency_take(&s_stream_lat_pending, &s_stream_lat_ms);
 }
 
 static uint8_t audio_stream_try_start(void)
@@ -1244,14 +1241,9 @@ static audio_voice_t *audio_find_lowest_prio_voice(void)
   return victim;
 }
 
-static uint8_t audio_voice_start(audio_voice_t *voice, const sound_registry_entry_t *entry,
-                                 sound_prio_t prio, sound_flags_t flags)
+/* Locate and validate the IMA-ADPCM data an SFX voice plays from. */
+static uint8_t audio_sfx_wav(const sound_registry_entry_t *entry, wav_info_t *wav)
 {
-  if ((voice == NULL) || (entry == NULL))
-  {
-    return 0U;
-  }
-
   const uint8_t *data = NULL;
   uint32_t data_len = 0U;
 
@@ -1272,19 +1264,35 @@ static uint8_t audio_voice_start(audio_voice_t *voice, const sound_registry_entr
     return 0U;
   }
 
-  wav_info_t wav;
-  if (audio_parse_wav(data, data_len, &wav) == 0U)
+  if (audio_parse_wav(data, data_len, wav) == 0U)
   {
     return 0U;
   }
 
-  if ((wav.format != WAV_FORMAT_IMA_ADPCM) ||
-      (wav.sample_rate != kAudioSampleRate) ||
-      (wav.channels != 1U))
+  if ((wav->format != WAV_FORMAT_IMA_ADPCM) ||
+      (wav->sample_rate != kAudioSampleRate) ||
+      (wav->channels != 1U))
   {
     return 0U;
   }
+  return 1U;
+}
 
+static uint8_t audio_voice_start(audio_voice_t *voice, const sound_registry_entry_t *entry,
+                                 sound_prio_t prio, sound_flags_t flags)
+{
+  if ((voice == NULL) || (entry == NULL))
+  {
+    return 0U;
+  }
+
+  wav_info_t wav;
+  if (audio_sfx_wav(entry, &wav) == 0U)
+  {
+    return 0U;
+  }
+
+  audio_voice_stop(voice);
   voice->active = 1U;
   voice->id = entry->id;
   voice->prio = prio;
@@ -1294,9 +1302,66 @@ static uint8_t audio_voice_start(audio_voice_t *voice, const sound_registry_entr
                                        audio_category_gain_q8(entry->category));
   voice->wav = wav;
   audio_adpcm_reset(&voice->adpcm);
+  voice->pcm_pos = 0U;
+  if ((flags & SOUND_F_PCM_CACHE) != 0U)
+  {
+    audio_pcm_attach(voice);
+  }
+  audio_latency_take(&voice->lat_pending, &voice->lat_enqueue_ms);
   return 1U;
 }
 
+/*
+ * The ADPCM of a SOUND_F_PCM_CACHE sound was (re)loaded: drop any decoded
+ * copy of the old data and decode the new one ahead of its first play. A
+ * whole sound takes longer than a period to decode, so the decode only runs
+ * while the output is stopped; otherwise the first play fills the entry.
+ */
+static void audio_handle_preload(sound_id_t id)
+{
+  const sound_registry_entry_t *entry = sound_registry_get(id);
+  if ((entry == NULL) || ((entry->flags & SOUND_F_PCM_CACHE) == 0U) ||
+      ((uint32_t)id >= (uint32_t)SND_COUNT))
+  {
+    return;
+  }
+
+  audio_pcm_entry_t *pcm = &s_pcm_entries[id];
+  if ((pcm->state == AUDIO_PCM_FILLING) || (audio_pcm_in_use(pcm) != 0U))
+  {
+    /* Let the voices finish with it; the last one to stop drops it. */
+    pcm->stale = 1U;
+    return;
+  }
+  pcm->state = AUDIO_PCM_EMPTY;
+  pcm->stale = 0U;
+
+  if (s_audio_state != AUDIO_STATE_IDLE)
+  {
+    return;
+  }
+
+  wav_info_t wav;
+  if (audio_sfx_wav(entry, &wav) == 0U)
+  {
+    return;
+  }
+
+  if (audio_pcm_alloc(pcm, wav.total_frames) == 0U)
+  {
+    return;
+  }
+
+  adpcm_state_t adpcm;
+  audio_adpcm_reset(&adpcm);
+  uint32_t n = audio_adpcm_decode(&wav, &adpcm, &s_pcm_arena[pcm->offset], wav.total_frames);
+  if (n != 0U)
+  {
+    pcm->samples = n;
+    pcm->state = AUDIO_PCM_READY;
+  }
+}
+
 static void audio_handle_sfx_play(const sound_registry_entry_t *entry, sound_prio_t prio,
                                   sound_flags_t flags)
 {
@@ -1329,14 +1394,9 @@ static void audio_handle_sfx_play(const sound_registry_entry_t *entry, sound_pri
   (void)audio_voice_start(voice, entry, prio, flags);
 }
 
-static void audio_handle_play(sound_id_t id, sound_prio_t prio, sound_flags_t flags)
+static void audio_handle_play_entry(const sound_registry_entry_t *entry, sound_prio_t prio,
+                                    sound_flags_t flags)
 {
-  const sound_registry_entry_t *entry = sound_registry_get(id);
-  if (entry == NULL)
-  {
-    return;
-  }
-
   sound_flags_t effective_flags = (sound_flags_t)(entry->flags | flags);
 
   if ((power_task_is_sleepface_active() != 0U) &&
@@ -1354,6 +1414,21 @@ static void audio_handle_play(sound_id_t id, sound_prio_t prio, sound_flags_t fl
   audio_handle_sfx_play(entry, prio, effective_flags);
 }
 
+static void audio_handle_play(sound_id_t id, sound_prio_t prio, sound_flags_t flags, uint8_t lat_tag)
+{
+  const sound_registry_entry_t *entry = sound_registry_get(id);
+  if (entry == NULL)
+  {
+    return;
+  }
+
+  s_lat_request = (lat_tag != 0U) ? 1U : 0U;
+  s_lat_request_ms = s_lat_slot_ms[lat_tag];
+  audio_handle_play_entry(entry, prio, flags);
+  /* Not taken by a source: the play was dropped and is not timed. */
+  s_lat_request = 0U;
+}
+
 static void audio_handle_stop(sound_id_t id)
 {
   if ((s_stream_active != 0U) || (s_stream_wait != 0U))
@@ -1372,7 +1447,7 @@ static void audio_handle_stop(sound_id_t id)
   {
     if ((s_sfx_voices[i].active != 0U) && (s_sfx_voices[i].id == id))
     {
-      s_sfx_voices[i].active = 0U;
+      audio_voice_stop(&s_sfx_voices[i]);
     }
   }
 }
@@ -1414,18 +1489,20 @@ void audio_task_run(void)
                                                  osFlagsWaitAny, 20U);
       if (flags >= 0)
       {
-        uint32_t half_count = (uint32_t)(sizeof(s_audio_buf) / sizeof(s_audio_buf[0]) / 2U);
+        uint32_t half_count = s_audio_period;
         if (((uint32_t)flags & kAudioFlagHalf) != 0U)
         {
+          audio_latency_half_playing(1U);
           audio_mix_fill(&s_audio_buf[0], half_count);
         }
         if (((uint32_t)flags & kAudioFlagFull) != 0U)
         {
+          audio_latency_half_playing(0U);
           audio_mix_fill(&s_audio_buf[half_count], half_count);
           if (s_audio_dma_circular == 0U)
           {
             (void)HAL_SAI_Transmit_DMA(&hsai_BlockA1, (uint8_t *)s_audio_buf,
-                                       (uint16_t)(sizeof(s_audio_buf) / sizeof(s_audio_buf[0])));
+                                       (uint16_t)(half_count * 2U));
           }
         }
         if (((uint32_t)flags & kAudioFlagError) != 0U)
@@ -1436,7 +1513,7 @@ void audio_task_run(void)
       else if ((s_audio_dma_circular == 0U) && (hsai_BlockA1.State == HAL_SAI_STATE_READY))
       {
         (void)HAL_SAI_Transmit_DMA(&hsai_BlockA1, (uint8_t *)s_audio_buf,
-                                   (uint16_t)(sizeof(s_audio_buf) / sizeof(s_audio_buf[0])));
+                                   (uint16_t)(s_audio_period * 2U));
       }
 
       if ((s_stream_active != 0U) && (storage_stream_has_error() != 0U))
@@ -1476,7 +1553,8 @@ void audio_task_run(void)
     {
       if (SOUND_CMD_IS(cmd, SOUND_CMD_TYPE_PLAY))
       {
-        audio_handle_play(SOUND_CMD_GET_ID(cmd), SOUND_CMD_GET_PRIO(cmd), SOUND_CMD_GET_FLAGS(cmd));
+        audio_handle_play(SOUND_CMD_GET_ID(cmd), SOUND_CMD_GET_PRIO(cmd), SOUND_CMD_GET_FLAGS(cmd),
+                          SOUND_CMD_GET_LAT(cmd));
       }
       else if (SOUND_CMD_IS(cmd, SOUND_CMD_TYPE_STOP))
       {
@@ -1486,6 +1564,10 @@ void audio_task_run(void)
       {
         audio_stop_all();
       }
+      else if (SOUND_CMD_IS(cmd, SOUND_CMD_TYPE_PRELOAD))
+      {
+        audio_handle_preload(SOUND_CMD_GET_ID(cmd));
+      }
     }
     else
     {
@@ -1495,11 +1577,11 @@ void audio_task_run(void)
           audio_stop_all();
           break;
         case APP_AUDIO_CMD_KEYCLICK:
-          audio_handle_play(SND_UI_MOVE, SOUND_PRIO_UI, 0U);
+          audio_handle_play(SND_UI_MOVE, SOUND_PRIO_UI, 0U, 0U);
           break;
         case APP_AUDIO_CMD_MUSIC_TOGGLE:
         case APP_AUDIO_CMD_FLASH_TOGGLE:
-          audio_handle_play(SND_MUSIC_MEGAMAN, SOUND_PRIO_MUSIC, 0U);
+          audio_handle_play(SND_MUSIC_MEGAMAN, SOUND_PRIO_MUSIC, 0U, 0U);
           break;
         default:
           break;
@@ -1600,3 +1682,23 @@ uint8_t audio_is_active(void)
 {
   return audio_has_pending();
 }
+
+uint8_t audio_latency_mark_enqueue(void)
+{
+  const uint32_t now = osKernelGetTickCount();
+  int32_t lock = osKernelLock();
+  uint8_t tag = s_lat_next_tag;
+  s_lat_next_tag = (uint8_t)((tag >= (AUDIO_LAT_SLOTS - 1U)) ? 1U : (tag + 1U));
+  s_lat_slot_ms[tag] = now;
+  (void)osKernelRestoreLock(lock);
+  return tag;
+}
+
+void audio_get_latency_stats(audio_latency_stats_t *out)
+{
+  if (out == NULL)
+  {
+    return;
+  }
+  *out = s_lat_stats;
+}
@@ -17,6 +17,20 @@ void debug_uart_tx_done(void)
 #endif
 }
 
+void debug_uart_wait_idle(uint32_t timeout_ms)
+{
+#if DEBUGGING
+  uint32_t waited = 0U;
+  while ((g_debug_uart_busy != 0U) && (waited < timeout_ms))
+  {
+    (void)osDelay(1U);
+    ++waited;
+  }
+#else
+  (void)timeout_ms;
+#endif
+}
+
 void debug_uart_log(const char *msg)
 {
 #if DEBUGGING
@@ -1,6 +1,7 @@
 #include "display_renderer.h"
 #include "font8x8_basic.h"
 
+#include <stddef.h>
 #include <string.h>
 
 #define DIRTY_WORD_COUNT ((DISPLAY_HEIGHT + 31U) / 32U)
@@ -11,17 +12,178 @@
   #define DIRTY_LAST_WORD_MASK ((1UL << (DISPLAY_HEIGHT % 32U)) - 1UL)
 #endif
 
-#define RENDER_UI_SHIFT 0U
-#define RENDER_UI_MASK (0x3U << RENDER_UI_SHIFT)
-#define RENDER_GAME_SHIFT 2U
-#define RENDER_GAME_MASK (0x3U << RENDER_GAME_SHIFT)
-#define RENDER_BG_SHIFT 4U
-#define RENDER_BG_MASK (0x1U << RENDER_BG_SHIFT)
-
-static void renderDrawHLineClamped(int32_t x0, int32_t x1, int32_t y, render_layer_t layer, render_state_t state);
-static void renderDrawVLineClamped(int32_t x, int32_t y0, int32_t y1, render_layer_t layer, render_state_t state);
+/*
+ * Layer storage is planar: every physical row keeps one bitplane per layer
+ * attribute, packed LSB-first into 32-bit words (bit n of word w is x = 32*w + n).
+ *
+ *   ui_opaque / game_opaque : 1 = layer covers the pixel
+ *   ui_color  / game_color  : 1 = white, only meaningful where opaque
+ *   bg_color                : 1 = white
+ *
+ * Colors use the panel convention (1 = white) so resolving a row is a handful
+ * of word-wide boolean ops and the result is already in panel byte order on a
+ * little-endian core.
+ */
+#define PLANE_WORDS ((DISPLAY_WIDTH + 31U) / 32U)
+
+typedef struct
+{
+  uint32_t ui_opaque[PLANE_WORDS];
+  uint32_t ui_color[PLANE_WORDS];
+  uint32_t game_opaque[PLANE_WORDS];
+  uint32_t game_color[PLANE_WORDS];
+  uint32_t bg_color[PLANE_WORDS];
+} render_row_planes_t;
+
+/*
+ * A (layer, state) pair resolved once per primitive into the two planes it
+ * writes and the masks it writes them with, so every kernel updates a plane
+ * word with the same branch-free ops whatever the layer and state:
+ *
+ *   opaque = (opaque & ~(mask & opaque_clear)) | (mask & opaque_set)
+ *   color  = (color  & ~(mask & color_clear[y & 3]))  | (mask & color_set[y & 3])
+ *
+ * The color masks are indexed by physical row so dither states are the same
+ * ops: their masks are a 4x4 Bayer pattern, which repeats every 4 pixels and
+ * so tiles a 32-bit plane word exactly. Solid states repeat one mask.
+ *
+ * The background has no opaque plane; its inks point both offsets at
+ * bg_color and leave the opaque update as a no-op.
+ */
+typedef struct
+{
+  uint16_t opaque; /* byte offsets into render_row_planes_t */
+  uint16_t color;
+  uint32_t opaque_set;
+  uint32_t opaque_clear;
+  uint32_t color_set[4];
+  uint32_t color_clear[4];
+} render_ink_t;
+
+/*      layer  state        opaque plane  color plane  opaque  color */
+#define RENDER_INK_TABLE(X)                                            \
+  X(UI,   TRANSPARENT, ui_opaque,   ui_color,   CLEAR, KEEP)           \
+  X(UI,   BLACK,       ui_opaque,   ui_color,   SET,   CLEAR)          \
+  X(UI,   WHITE,       ui_opaque,   ui_color,   SET,   SET)            \
+  X(GAME, TRANSPARENT, game_opaque, game_color, CLEAR, KEEP)           \
+  X(GAME, BLACK,       game_opaque, game_color, SET,   CLEAR)          \
+  X(GAME, WHITE,       game_opaque, game_color, SET,   SET)            \
+  X(BG,   TRANSPARENT, bg_color,    bg_color,   KEEP,  KEEP)           \
+  X(BG,   BLACK,       bg_color,    bg_color,   KEEP,  CLEAR)          \
+  X(BG,   WHITE,       bg_color,    bg_color,   KEEP,  SET)
+
+#define INK_SET_KEEP    0U
+#define INK_SET_SET     0xFFFFFFFFU
+#define INK_SET_CLEAR   0U
+#define INK_CLEAR_KEEP  0U
+#define INK_CLEAR_SET   0U
+#define INK_CLEAR_CLEAR 0xFFFFFFFFU
+
+#define INK_ROWS(mask) { (mask), (mask), (mask), (mask) }
+
+#define RENDER_INK_ENTRY(layer, state, opaque_plane, color_plane, opaque_op, color_op)      \
+  [RENDER_LAYER_##layer][RENDER_STATE_##state] =                                              \
+    { (uint16_t)offsetof(render_row_planes_t, opaque_plane),                                  \
+      (uint16_t)offsetof(render_row_planes_t, color_plane),                                   \
+      INK_SET_##opaque_op, INK_CLEAR_##opaque_op,                                             \
+      INK_ROWS(INK_SET_##color_op), INK_ROWS(INK_CLEAR_##color_op) },
+
+/*
+ * Dither masks: bit c of row r is BLACK when the 4x4 Bayer threshold at
+ * (c, r) is below `level`, replicated across the word.
+ */
+#define BAYER_BIT(threshold, level, c) (((threshold) < (level)) ? (1U << (c)) : 0U)
+#define BAYER_ROW(t0, t1, t2, t3, level)                                                      \
+  ((uint32_t)(BAYER_BIT(t0, level, 0U) | BAYER_BIT(t1, level, 1U) |                           \
+              BAYER_BIT(t2, level, 2U) | BAYER_BIT(t3, level, 3U)) * 0x11111111U)
+#define BAYER_MASKS(level, inv)                                                               \
+  { (inv) ^ BAYER_ROW(0U, 8U, 2U, 10U, level), (inv) ^ BAYER_ROW(12U, 4U, 14U, 6U, level),  \
+    (inv) ^ BAYER_ROW(3U, 11U, 1U, 9U, level), (inv) ^ BAYER_ROW(15U, 7U, 13U, 5U, level) }
+
+#define RENDER_INK_DITHER_ENTRY(layer, opaque_plane, color_plane, opaque_op, level)          \
+  [RENDER_LAYER_##layer][RENDER_STATE_DITHER_FIRST + (level) - 1U] =                          \
+    { (uint16_t)offsetof(render_row_planes_t, opaque_plane),                                  \
+      (uint16_t)offsetof(render_row_planes_t, color_plane),                                   \
+      INK_SET_##opaque_op, INK_CLEAR_##opaque_op,                                             \
+      BAYER_MASKS(level, 0xFFFFFFFFU), BAYER_MASKS(level, 0U) },
+
+#define RENDER_INK_DITHER(X, layer, opaque_plane, color_plane, opaque_op)                     \
+  X(layer, opaque_plane, color_plane, opaque_op, 1U)  X(layer, opaque_plane, color_plane, opaque_op, 2U)  \
+  X(layer, opaque_plane, color_plane, opaque_op, 3U)  X(layer, opaque_plane, color_plane, opaque_op, 4U)  \
+  X(layer, opaque_plane, color_plane, opaque_op, 5U)  X(layer, opaque_plane, color_plane, opaque_op, 6U)  \
+  X(layer, opaque_plane, color_plane, opaque_op, 7U)  X(layer, opaque_plane, color_plane, opaque_op, 8U)  \
+  X(layer, opaque_plane, color_plane, opaque_op, 9U)  X(layer, opaque_plane, color_plane, opaque_op, 10U) \
+  X(layer, opaque_plane, color_plane, opaque_op, 11U) X(layer, opaque_plane, color_plane, opaque_op, 12U) \
+  X(layer, opaque_plane, color_plane, opaque_op, 13U) X(layer, opaque_plane, color_plane, opaque_op, 14U) \
+  X(layer, opaque_plane, color_plane, opaque_op, 15U)
+
+#define RENDER_STATE_COUNT ((uint32_t)RENDER_STATE_DITHER_LAST + 1U)
+
+static const render_ink_t kRenderInks[3][RENDER_STATE_COUNT] =
+{
+  RENDER_INK_TABLE(RENDER_INK_ENTRY)
+  RENDER_INK_DITHER(RENDER_INK_DITHER_ENTRY, UI,   ui_opaque,   ui_color,   SET)
+  RENDER_INK_DITHER(RENDER_INK_DITHER_ENTRY, GAME, game_opaque, game_color, SET)
+  RENDER_INK_DITHER(RENDER_INK_DITHER_ENTRY, BG,   bg_color,    bg_color,   KEEP)
+};
+
+/* Out-of-range layers draw to GAME and out-of-range states are transparent. */
+static const render_ink_t *render_ink(render_layer_t layer, render_state_t state)
+{
+  uint32_t l = (uint32_t)RENDER_LAYER_GAME;
+  if ((layer == RENDER_LAYER_UI) || (layer == RENDER_LAYER_BG))
+  {
+    l = (uint32_t)layer;
+  }
+  uint32_t st = (uint32_t)RENDER_STATE_TRANSPARENT;
+  if ((uint32_t)state < RENDER_STATE_COUNT)
+  {
+    st = (uint32_t)state;
+  }
+  return &kRenderInks[l][st];
+}
 
-/* Place framebuffer in SRAM4 for LPDMA access. */
+/*
+ * Plot up to 32 pixels along logical +x (run_x) or +y (run_y) starting at
+ * (x, y). Bit i of `bits` selects the i-th pixel of the run. Callers clip to
+ * the logical screen first.
+ */
+typedef void (*render_run_fn)(uint16_t x, uint16_t y, uint32_t bits, uint8_t count, const render_ink_t *ink);
+
+/*
+ * Per-rotation mapping, selected once in renderSetRotation():
+ *   px = origin_x + x * x_step_px + y * y_step_px
+ *   py = origin_y + x * x_step_py + y * y_step_py
+ * plus the run kernels that walk a logical row or column in physical memory
+ * order.
+ */
+typedef struct
+{
+  uint16_t width;
+  uint16_t height;
+  int16_t origin_x;
+  int16_t origin_y;
+  int8_t x_step_px;
+  int8_t x_step_py;
+  int8_t y_step_px;
+  int8_t y_step_py;
+  render_run_fn run_x;
+  render_run_fn run_y;
+} render_xform_t;
+
+static void renderDrawHLineClamped(int32_t x0, int32_t x1, int32_t y, const render_ink_t *ink);
+static void renderDrawVLineClamped(int32_t x, int32_t y0, int32_t y1, const render_ink_t *ink);
+static void render_fill_circle(uint16_t x0, uint16_t y0, uint16_t radius, const render_ink_t *ink);
+
+/*
+ * Packed framebuffers live in SRAM4 for LPDMA access. There are two: each
+ * renderTakeDirtyRows() that returns rows packs into the back buffer and then
+ * flips, so the display task can pack frame N+1 while frame N is still being
+ * transmitted from the other one.
+ *
+ * They are kept in panel stream layout (LCD_StreamInit), so the LCD driver
+ * can DMA straight out of them without copying rows into a tx buffer.
+ */
 #if defined(__GNUC__)
   #define SRAM4_BUF_ATTR __attribute__((section(".sram4"))) __attribute__((aligned(4)))
 #elif defined(__ICCARM__)
@@ -30,12 +192,25 @@ static void renderDrawVLineClamped(int32_t x, int32_t y0, int32_t y1, render_lay
   #define SRAM4_BUF_ATTR
 #endif
 
-static uint8_t s_packed_buffer[BUFFER_LENGTH] SRAM4_BUF_ATTR;
-static uint8_t s_l8_buffer[DISPLAY_WIDTH * DISPLAY_HEIGHT] __attribute__((aligned(4)));
+#define PACKED_BUFFER_COUNT 2U
+
+static uint8_t s_packed_buffer[PACKED_BUFFER_COUNT][LCD_STREAM_LENGTH] SRAM4_BUF_ATTR;
+static uint8_t s_pack_index = 0U;
+static uint8_t s_front_index = 1U;
+/* Cursor of the renderBeginDirtyRows() pass in progress. */
+static uint16_t s_take_row = DISPLAY_HEIGHT + 1U;
+static uint16_t s_take_count = 0U;
+/* Rows packed into the other buffer since this one last saw them. */
+static uint32_t s_stale_mask[PACKED_BUFFER_COUNT][DIRTY_WORD_COUNT];
+static render_row_planes_t s_planes[DISPLAY_HEIGHT];
 static uint32_t s_dirty_mask[DIRTY_WORD_COUNT];
+static uint32_t s_force_mask[DIRTY_WORD_COUNT];
+static uint8_t s_dirty_lo[DISPLAY_HEIGHT];
+static uint8_t s_dirty_hi[DISPLAY_HEIGHT];
+static bool s_frame_diff = true;
+static uint32_t s_sent_hash[DISPLAY_HEIGHT];
 static render_rotation_t s_rotation = RENDER_ROTATION_270_CW;
-
-static uint8_t s_resolve_lut[256];
+static const render_xform_t *s_xform;
 
 static bool normalize_span(uint16_t *start_row, uint16_t *end_row)
 {
@@ -73,16 +248,8 @@ static void render_get_logical_dims(uint16_t *width, uint16_t *height)
     return;
   }
 
-  if ((s_rotation == RENDER_ROTATION_90_CW) || (s_rotation == RENDER_ROTATION_270_CW))
-  {
-    *width = DISPLAY_HEIGHT;
-    *height = DISPLAY_WIDTH;
-  }
-  else
-  {
-    *width = DISPLAY_WIDTH;
-    *height = DISPLAY_HEIGHT;
-  }
+  *width = s_xform->width;
+  *height = s_xform->height;
 }
 
 static bool normalize_logical_span(uint16_t *start_row, uint16_t *end_row)
@@ -125,487 +292,1020 @@ static bool render_map_xy(uint16_t x, uint16_t y, uint16_t *out_x, uint16_t *out
     return false;
   }
 
-  uint16_t width = 0U;
-  uint16_t height = 0U;
-  render_get_logical_dims(&width, &height);
-  if ((x >= width) || (y >= height))
+  const render_xform_t *xf = s_xform;
+  if ((x >= xf->width) || (y >= xf->height))
   {
     return false;
   }
 
-  switch (s_rotation)
-  {
-    case RENDER_ROTATION_0:
-      *out_x = x;
-      *out_y = y;
-      break;
-    case RENDER_ROTATION_90_CW:
-      *out_x = y;
-      *out_y = (uint16_t)(DISPLAY_HEIGHT - 1U - x);
-      break;
-    case RENDER_ROTATION_180:
-      *out_x = (uint16_t)(DISPLAY_WIDTH - 1U - x);
-      *out_y = (uint16_t)(DISPLAY_HEIGHT - 1U - y);
-      break;
-    case RENDER_ROTATION_270_CW:
-      *out_x = (uint16_t)(DISPLAY_WIDTH - 1U - y);
-      *out_y = x;
-      break;
-    default:
-      return false;
-  }
-
+  *out_x = (uint16_t)(xf->origin_x + ((int32_t)x * xf->x_step_px) + ((int32_t)y * xf->y_step_px));
+  *out_y = (uint16_t)(xf->origin_y + ((int32_t)x * xf->x_step_py) + ((int32_t)y * xf->y_step_py));
   return true;
 }
 
-static uint8_t get_ui_state(uint8_t pixel)
-{
-  return (uint8_t)((pixel & RENDER_UI_MASK) >> RENDER_UI_SHIFT);
-}
+/*
+ * Damage tracking.
+ *
+ * s_dirty_mask holds one bit per physical row (bit n = row n + 1). The panel
+ * always takes whole lines, but each dirty row also records the packed byte
+ * range [lo, hi] that was touched, so the portable pack_row() only
+ * re-resolves those bytes. A row with lo > hi has nothing to repack.
+ *
+ * Rows marked through the public renderMarkDirty* calls are "forced": they
+ * are handed to the flush even when frame diffing finds their packed line
+ * unchanged, which is how the display task retries a failed transfer.
+ */
+#define DIRTY_EXTENT_EMPTY_LO ((uint8_t)0xFFU)
+#define DIRTY_EXTENT_EMPTY_HI ((uint8_t)0x00U)
 
-static uint8_t get_game_state(uint8_t pixel)
+static void dirty_clear_all(void)
 {
-  return (uint8_t)((pixel & RENDER_GAME_MASK) >> RENDER_GAME_SHIFT);
+  memset(s_dirty_mask, 0, sizeof(s_dirty_mask));
+  memset(s_force_mask, 0, sizeof(s_force_mask));
+  memset(s_dirty_lo, DIRTY_EXTENT_EMPTY_LO, sizeof(s_dirty_lo));
+  memset(s_dirty_hi, DIRTY_EXTENT_EMPTY_HI, sizeof(s_dirty_hi));
 }
 
-static uint8_t set_ui_state(uint8_t pixel, uint8_t state)
+static void dirty_set_all(void)
 {
-  pixel &= (uint8_t)~RENDER_UI_MASK;
-  pixel |= (uint8_t)((state & 0x3U) << RENDER_UI_SHIFT);
-  return pixel;
+  for (uint32_t i = 0U; i < DIRTY_WORD_COUNT; ++i)
+  {
+    s_dirty_mask[i] = 0xFFFFFFFFU;
+  }
+  s_dirty_mask[DIRTY_WORD_COUNT - 1U] = DIRTY_LAST_WORD_MASK;
+  memset(s_dirty_lo, 0, sizeof(s_dirty_lo));
+  memset(s_dirty_hi, LINE_WIDTH - 1U, sizeof(s_dirty_hi));
 }
 
-static uint8_t set_game_state(uint8_t pixel, uint8_t state)
+static bool dirty_any(void)
 {
-  pixel &= (uint8_t)~RENDER_GAME_MASK;
-  pixel |= (uint8_t)((state & 0x3U) << RENDER_GAME_SHIFT);
-  return pixel;
+  for (uint32_t i = 0U; i < DIRTY_WORD_COUNT; ++i)
+  {
+    if (s_dirty_mask[i] != 0U)
+    {
+      return true;
+    }
+  }
+  return false;
 }
 
-static uint8_t set_bg_state(uint8_t pixel, render_state_t state)
+/* Mark packed bytes lo..hi of physical row y (0-based) dirty. */
+static inline void dirty_mark_bytes(uint32_t y, uint32_t lo, uint32_t hi)
 {
-  if (state == RENDER_STATE_BLACK)
+  s_dirty_mask[y / 32U] |= (1UL << (y % 32U));
+  if (lo < s_dirty_lo[y])
   {
-    pixel |= RENDER_BG_MASK;
+    s_dirty_lo[y] = (uint8_t)lo;
   }
-  else if (state == RENDER_STATE_WHITE)
+  if (hi > s_dirty_hi[y])
   {
-    pixel &= (uint8_t)~RENDER_BG_MASK;
+    s_dirty_hi[y] = (uint8_t)hi;
   }
-  return pixel;
 }
 
-static uint8_t apply_layer_state(uint8_t pixel, render_layer_t layer, render_state_t state)
+static void dirty_force_row(uint16_t row)
 {
-  if (layer == RENDER_LAYER_UI)
-  {
-    return set_ui_state(pixel, (uint8_t)state);
-  }
-  if (layer == RENDER_LAYER_GAME)
+  if ((row < 1U) || (row > DISPLAY_HEIGHT))
   {
-    return set_game_state(pixel, (uint8_t)state);
+    return;
   }
-  return set_bg_state(pixel, state);
+  uint32_t idx = (uint32_t)(row - 1U);
+  s_force_mask[idx / 32U] |= (1UL << (idx % 32U));
+  dirty_mark_bytes(idx, 0U, LINE_WIDTH - 1U);
 }
 
-static uint8_t swap_bw_state(uint8_t state)
+/* Mark physical pixels [x0, x1] x [y0, y1] (0-based, inclusive) dirty. */
+static void dirty_set_physical_rect(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
 {
-  if (state == RENDER_STATE_BLACK)
+  if ((y0 > y1) || (y0 >= DISPLAY_HEIGHT))
   {
-    return RENDER_STATE_WHITE;
+    return;
   }
-  if (state == RENDER_STATE_WHITE)
+  if (y1 >= DISPLAY_HEIGHT)
   {
-    return RENDER_STATE_BLACK;
+    y1 = (uint16_t)(DISPLAY_HEIGHT - 1U);
+  }
+
+  uint32_t lo = (uint32_t)x0 >> 3U;
+  uint32_t hi = (uint32_t)x1 >> 3U;
+  for (uint32_t y = y0; y <= y1; ++y)
+  {
+    dirty_mark_bytes(y, lo, hi);
   }
-  return state;
 }
 
-static void build_resolve_lut(void)
+static void dirty_clear_row(uint16_t row)
 {
-  for (uint32_t i = 0U; i < 256U; i++)
+  if ((row < 1U) || (row > DISPLAY_HEIGHT))
   {
-    uint8_t pixel = (uint8_t)i;
-
-    uint8_t ui = get_ui_state(pixel);
-    if (ui == RENDER_STATE_BLACK)
-    {
-      s_resolve_lut[i] = 0U;
-      continue;
-    }
-    if (ui == RENDER_STATE_WHITE)
-    {
-      s_resolve_lut[i] = 1U;
-      continue;
-    }
-
-    uint8_t game = get_game_state(pixel);
-    if (game == RENDER_STATE_BLACK)
-    {
-      s_resolve_lut[i] = 0U;
-      continue;
-    }
-    if (game == RENDER_STATE_WHITE)
-    {
-      s_resolve_lut[i] = 1U;
-      continue;
-    }
-
-    s_resolve_lut[i] = ((pixel & RENDER_BG_MASK) != 0U) ? 0U : 1U;
+    return;
   }
+  uint32_t idx = (uint32_t)(row - 1U);
+  s_dirty_mask[idx / 32U] &= ~(1UL << (idx % 32U));
+  s_force_mask[idx / 32U] &= ~(1UL << (idx % 32U));
+  s_dirty_lo[idx] = DIRTY_EXTENT_EMPTY_LO;
+  s_dirty_hi[idx] = DIRTY_EXTENT_EMPTY_HI;
 }
 
-static uint8_t resolve_pixel(uint8_t pixel)
+static bool dirty_is_forced(uint16_t row)
 {
-  return s_resolve_lut[pixel];
+  uint32_t idx = (uint32_t)(row - 1U);
+  return ((s_force_mask[idx / 32U] >> (idx % 32U)) & 1UL) != 0U;
 }
 
-
-static uint8_t invert_pixel(uint8_t pixel)
+static bool dirty_is_row(uint16_t row)
 {
-  uint8_t ui = get_ui_state(pixel);
-  if ((ui == RENDER_STATE_BLACK) || (ui == RENDER_STATE_WHITE))
+  if ((row < 1U) || (row > DISPLAY_HEIGHT))
   {
-    return set_ui_state(pixel, swap_bw_state(ui));
+    return false;
   }
+  uint32_t idx = (uint32_t)(row - 1U);
+  return ((s_dirty_mask[idx / 32U] >> (idx % 32U)) & 1UL) != 0U;
+}
 
-  uint8_t game = get_game_state(pixel);
-  if ((game == RENDER_STATE_BLACK) || (game == RENDER_STATE_WHITE))
+static void planes_clear_row(render_row_planes_t *planes, bool fill)
+{
+  memset(planes, 0, sizeof(*planes));
+  if (!fill)
   {
-    return set_game_state(pixel, swap_bw_state(game));
+    memset(planes->bg_color, 0xFF, sizeof(planes->bg_color));
   }
+}
+
+/* Apply an ink to every pixel selected by `mask` in one plane word of physical row y. */
+static inline void planes_apply_word(uint32_t y, uint32_t word, uint32_t mask, const render_ink_t *ink)
+{
+  uint8_t *planes = (uint8_t *)&s_planes[y];
+  uint32_t *opaque = (uint32_t *)(planes + ink->opaque);
+  uint32_t *color = (uint32_t *)(planes + ink->color);
 
-  return (uint8_t)(pixel ^ (uint8_t)RENDER_BG_MASK);
+  opaque[word] = (opaque[word] & ~(mask & ink->opaque_clear)) | (mask & ink->opaque_set);
+  color[word] = (color[word] & ~(mask & ink->color_clear[y & 3U])) | (mask & ink->color_set[y & 3U]);
 }
 
-static void dirty_clear_all(void)
+static void render_set_pixel_physical(uint16_t x, uint16_t y, const render_ink_t *ink)
 {
-  memset(s_dirty_mask, 0, sizeof(s_dirty_mask));
+  planes_apply_word(y, (uint32_t)x >> 5U, 1UL << (x & 31U), ink);
+  dirty_mark_bytes(y, (uint32_t)x >> 3U, (uint32_t)x >> 3U);
 }
 
-static void dirty_set_all(void)
+/* Invert the topmost opaque layer under each bit set in `mask`. */
+static void planes_invert_word(render_row_planes_t *planes, uint32_t word, uint32_t mask)
 {
-  for (uint32_t i = 0U; i < DIRTY_WORD_COUNT; ++i)
+  uint32_t ui = planes->ui_opaque[word];
+  uint32_t game = planes->game_opaque[word];
+
+  planes->ui_color[word] ^= (ui & mask);
+  planes->game_color[word] ^= (game & ~ui & mask);
+  planes->bg_color[word] ^= (~(ui | game) & mask);
+}
+
+/*
+ * Span kernels.
+ *
+ * A physical span [x0, x1] touches at most PLANE_WORDS words per plane, so
+ * horizontal runs are written 32 pixels per store with edge masks and the row
+ * is marked dirty once. Vertical runs write one bit per row and mark the whole
+ * row range dirty in one pass.
+ */
+typedef enum
+{
+  SPAN_OP_APPLY = 0,
+  SPAN_OP_CLEAR_BG_WHITE,
+  SPAN_OP_CLEAR_BG_BLACK,
+  SPAN_OP_INVERT
+} span_op_t;
+
+static void planes_span_word(uint32_t y, uint32_t word, uint32_t mask, span_op_t op, const render_ink_t *ink)
+{
+  render_row_planes_t *planes = &s_planes[y];
+  switch (op)
   {
-    s_dirty_mask[i] = 0xFFFFFFFFU;
+    case SPAN_OP_APPLY:
+      planes_apply_word(y, word, mask, ink);
+      break;
+    case SPAN_OP_CLEAR_BG_WHITE:
+    case SPAN_OP_CLEAR_BG_BLACK:
+      planes->ui_opaque[word] &= ~mask;
+      planes->game_opaque[word] &= ~mask;
+      if (op == SPAN_OP_CLEAR_BG_BLACK)
+      {
+        planes->bg_color[word] &= ~mask;
+      }
+      else
+      {
+        planes->bg_color[word] |= mask;
+      }
+      break;
+    case SPAN_OP_INVERT:
+      planes_invert_word(planes, word, mask);
+      break;
+    default:
+      break;
   }
-  s_dirty_mask[DIRTY_WORD_COUNT - 1U] = DIRTY_LAST_WORD_MASK;
 }
 
-static bool dirty_any(void)
+/* Run `op` over the physical rectangle [x0, x1] x [y0, y1] (inclusive); `ink` is only read by APPLY. */
+static void render_span_rect_physical(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, span_op_t op,
+                                      const render_ink_t *ink)
 {
-  for (uint32_t i = 0U; i < DIRTY_WORD_COUNT; ++i)
+  uint32_t w0 = (uint32_t)x0 >> 5U;
+  uint32_t w1 = (uint32_t)x1 >> 5U;
+  uint32_t head = 0xFFFFFFFFU << (x0 & 31U);
+  uint32_t tail = 0xFFFFFFFFU >> (31U - (x1 & 31U));
+
+  for (uint32_t y = y0; y <= y1; ++y)
   {
-    if (s_dirty_mask[i] != 0U)
+    if (w0 == w1)
     {
-      return true;
+      planes_span_word(y, w0, head & tail, op, ink);
+      continue;
+    }
+
+    planes_span_word(y, w0, head, op, ink);
+    for (uint32_t w = w0 + 1U; w < w1; ++w)
+    {
+      planes_span_word(y, w, 0xFFFFFFFFU, op, ink);
     }
+    planes_span_word(y, w1, tail, op, ink);
   }
-  return false;
+
+  dirty_set_physical_rect(x0, y0, x1, y1);
 }
 
-static void dirty_set_row(uint16_t row)
+/*
+ * Run `op` over a clipped logical rectangle. Every rotation maps an axis-aligned
+ * rectangle onto an axis-aligned physical rectangle, so only the two corners
+ * go through render_map_xy().
+ */
+static void render_span_rect_logical(uint16_t x, uint16_t y, uint16_t width, uint16_t height, span_op_t op,
+                                     const render_ink_t *ink)
 {
-  if ((row < 1U) || (row > DISPLAY_HEIGHT))
+  uint16_t ax = 0U;
+  uint16_t ay = 0U;
+  uint16_t bx = 0U;
+  uint16_t by = 0U;
+  if (!render_map_xy(x, y, &ax, &ay) ||
+      !render_map_xy((uint16_t)(x + width - 1U), (uint16_t)(y + height - 1U), &bx, &by))
   {
     return;
   }
-  uint32_t idx = (uint32_t)(row - 1U);
-  s_dirty_mask[idx / 32U] |= (1UL << (idx % 32U));
+
+  uint16_t x0 = (ax < bx) ? ax : bx;
+  uint16_t x1 = (ax < bx) ? bx : ax;
+  uint16_t y0 = (ay < by) ? ay : by;
+  uint16_t y1 = (ay < by) ? by : ay;
+  render_span_rect_physical(x0, y0, x1, y1, op, ink);
 }
 
-static void dirty_clear_row(uint16_t row)
+/*
+ * Run kernels, one pair per rotation. run_x walks a logical row and run_y a
+ * logical column; whichever of the two lands on a physical row is one or two
+ * masked word updates, the other steps one plane row per pixel at a fixed
+ * word and bit.
+ */
+static void run_physical_row(uint16_t px, uint16_t py, uint32_t bits, uint8_t count,
+                             const render_ink_t *ink)
 {
-  if ((row < 1U) || (row > DISPLAY_HEIGHT))
+  uint32_t word = (uint32_t)px >> 5U;
+  uint32_t shift = (uint32_t)px & 31U;
+
+  planes_apply_word(py, word, bits << shift, ink);
+  if ((shift != 0U) && ((shift + count) > 32U))
   {
-    return;
+    planes_apply_word(py, word + 1U, bits >> (32U - shift), ink);
   }
-  uint32_t idx = (uint32_t)(row - 1U);
-  s_dirty_mask[idx / 32U] &= ~(1UL << (idx % 32U));
+  dirty_mark_bytes(py, ((uint32_t)px + (uint32_t)__CLZ(__RBIT(bits))) >> 3U,
+                   ((uint32_t)px + 31U - (uint32_t)__CLZ(bits)) >> 3U);
 }
 
-static bool dirty_is_row(uint16_t row)
+/* Bit i of `bits` lands on physical row py + i * step, column px. */
+static void run_physical_col(uint16_t px, uint16_t py, int16_t step, uint32_t bits, const render_ink_t *ink)
 {
-  if ((row < 1U) || (row > DISPLAY_HEIGHT))
+  uint32_t word = (uint32_t)px >> 5U;
+  uint32_t mask = 1UL << (px & 31U);
+  uint32_t byte = (uint32_t)px >> 3U;
+
+  for (; bits != 0U; bits >>= 1U, py = (uint16_t)(py + step))
   {
-    return false;
+    if ((bits & 1U) != 0U)
+    {
+      planes_apply_word(py, word, mask, ink);
+      dirty_mark_bytes(py, byte, byte);
+    }
   }
-  uint32_t idx = (uint32_t)(row - 1U);
-  return ((s_dirty_mask[idx / 32U] >> (idx % 32U)) & 1UL) != 0U;
 }
 
-static void render_write_pixel_physical(uint16_t x, uint16_t y, uint8_t pixel)
+/* Reverse a run so bit 0 is the leftmost physical pixel of a mirrored span. */
+static inline uint32_t run_reverse(uint32_t bits, uint8_t count)
 {
-  uint32_t idx = ((uint32_t)y * DISPLAY_WIDTH) + x;
-  s_l8_buffer[idx] = (uint8_t)(pixel);
-  dirty_set_row((uint16_t)(y + 1U));
+  return __RBIT(bits) >> (32U - count);
 }
 
-static void render_set_pixel_physical(uint16_t x, uint16_t y, render_layer_t layer, render_state_t state)
+static void run_x_rot0(uint16_t x, uint16_t y, uint32_t bits, uint8_t count, const render_ink_t *ink)
 {
-  uint32_t idx = ((uint32_t)y * DISPLAY_WIDTH) + x;
-  uint8_t pixel = s_l8_buffer[idx];
-  pixel = apply_layer_state(pixel, layer, state);
-  s_l8_buffer[idx] = (uint8_t)(pixel);
-  dirty_set_row((uint16_t)(y + 1U));
+  run_physical_row(x, y, bits, count, ink);
 }
 
-static void render_invert_pixel_physical(uint16_t x, uint16_t y)
-{
-  uint32_t idx = ((uint32_t)y * DISPLAY_WIDTH) + x;
-  uint8_t pixel = s_l8_buffer[idx];
-  pixel = invert_pixel(pixel);
-  s_l8_buffer[idx] = (uint8_t)(pixel);
-  dirty_set_row((uint16_t)(y + 1U));
-}
-
-static void mark_dirty_span(uint16_t start_row, uint16_t end_row)
+static void run_y_rot0(uint16_t x, uint16_t y, uint32_t bits, uint8_t count, const render_ink_t *ink)
 {
-  if (!normalize_span(&start_row, &end_row))
-  {
-    return;
-  }
-
-  for (uint16_t row = start_row; row <= end_row; ++row)
-  {
-    dirty_set_row(row);
-  }
+  (void)count;
+  run_physical_col(x, y, 1, bits, ink);
 }
 
-static void pack_row(uint16_t row)
+static void run_x_rot90(uint16_t x, uint16_t y, uint32_t bits, uint8_t count, const render_ink_t *ink)
 {
-  uint32_t row_index = (uint32_t)(row - 1U);
-  uint8_t *dst = &s_packed_buffer[row_index * LINE_WIDTH];
-  uint8_t *src = &s_l8_buffer[row_index * DISPLAY_WIDTH];
-
-  /*
-   * Hot path: pack one LCD row (DISPLAY_WIDTH pixels) into LINE_WIDTH bytes.
-   *
-   * The panel expects LSB-first within each byte:
-   *   - bit0 corresponds to x+0
-   *   - bit7 corresponds to x+7
-   *
-   * We already built a 256-entry resolve LUT, so resolve is a single indexed load.
-   * Packing 8 pixels at a time avoids per-pixel branching and reduces loop overhead.
-   */
-  for (uint16_t byte = 0U; byte < LINE_WIDTH; ++byte)
-  {
-    uint16_t x = (uint16_t)(byte << 3U);
-
-    uint8_t b0 = s_resolve_lut[src[x + 0U]];
-    uint8_t b1 = s_resolve_lut[src[x + 1U]];
-    uint8_t b2 = s_resolve_lut[src[x + 2U]];
-    uint8_t b3 = s_resolve_lut[src[x + 3U]];
-    uint8_t b4 = s_resolve_lut[src[x + 4U]];
-    uint8_t b5 = s_resolve_lut[src[x + 5U]];
-    uint8_t b6 = s_resolve_lut[src[x + 6U]];
-    uint8_t b7 = s_resolve_lut[src[x + 7U]];
-
-    dst[byte] = (uint8_t)(((uint8_t)(b0 << 0U)) |
-                          ((uint8_t)(b1 << 1U)) |
-                          ((uint8_t)(b2 << 2U)) |
-                          ((uint8_t)(b3 << 3U)) |
-                          ((uint8_t)(b4 << 4U)) |
-                          ((uint8_t)(b5 << 5U)) |
-                          ((uint8_t)(b6 << 6U)) |
-                          ((uint8_t)(b7 << 7U)));
-  }
+  (void)count;
+  run_physical_col(y, (uint16_t)(DISPLAY_HEIGHT - 1U - x), -1, bits, ink);
 }
 
-
-void renderInit(void)
+static void run_y_rot90(uint16_t x, uint16_t y, uint32_t bits, uint8_t count, const render_ink_t *ink)
 {
-  memset(s_packed_buffer, 0xFF, BUFFER_LENGTH);
-  memset(s_l8_buffer, 0x00, sizeof(s_l8_buffer));
-  dirty_clear_all();
-  s_rotation = RENDER_ROTATION_270_CW;  build_resolve_lut();
+  run_physical_row(y, (uint16_t)(DISPLAY_HEIGHT - 1U - x), bits, count, ink);
 }
 
-
-void renderSetRotation(render_rotation_t rotation)
+static void run_x_rot180(uint16_t x, uint16_t y, uint32_t bits, uint8_t count, const render_ink_t *ink)
 {
-  if ((rotation == RENDER_ROTATION_0) ||
-      (rotation == RENDER_ROTATION_90_CW) ||
-      (rotation == RENDER_ROTATION_180) ||
-      (rotation == RENDER_ROTATION_270_CW))
-  {
-    s_rotation = rotation;
-  }
+  run_physical_row((uint16_t)(DISPLAY_WIDTH - x - count), (uint16_t)(DISPLAY_HEIGHT - 1U - y),
+                   run_reverse(bits, count), count, ink);
 }
 
-render_rotation_t renderGetRotation(void)
+static void run_y_rot180(uint16_t x, uint16_t y, uint32_t bits, uint8_t count, const render_ink_t *ink)
 {
-  return s_rotation;
+  (void)count;
+  run_physical_col((uint16_t)(DISPLAY_WIDTH - 1U - x), (uint16_t)(DISPLAY_HEIGHT - 1U - y), -1, bits, ink);
 }
 
-uint16_t renderGetWidth(void)
+static void run_x_rot270(uint16_t x, uint16_t y, uint32_t bits, uint8_t count, const render_ink_t *ink)
 {
-  uint16_t width = 0U;
-  uint16_t height = 0U;
-  render_get_logical_dims(&width, &height);
-  return width;
+  (void)count;
+  run_physical_col((uint16_t)(DISPLAY_WIDTH - 1U - y), x, 1, bits, ink);
 }
 
-uint16_t renderGetHeight(void)
+static void run_y_rot270(uint16_t x, uint16_t y, uint32_t bits, uint8_t count, const render_ink_t *ink)
 {
-  uint16_t width = 0U;
-  uint16_t height = 0U;
-  render_get_logical_dims(&width, &height);
-  return height;
+  run_physical_row((uint16_t)(DISPLAY_WIDTH - y - count), x, run_reverse(bits, count), count, ink);
 }
 
-const uint8_t *renderGetBuffer(void)
+static const render_xform_t kRenderXforms[4] =
 {
-  return s_packed_buffer;
-}
-
-bool renderTakeDirtyRows(uint16_t *rows, uint16_t max_rows, uint16_t *out_count, bool *out_full)
+  [RENDER_ROTATION_0] =
+    { DISPLAY_WIDTH, DISPLAY_HEIGHT, 0, 0, 1, 0, 0, 1, run_x_rot0, run_y_rot0 },
+  [RENDER_ROTATION_90_CW] =
+    { DISPLAY_HEIGHT, DISPLAY_WIDTH, 0, (int16_t)(DISPLAY_HEIGHT - 1U), 0, -1, 1, 0, run_x_rot90, run_y_rot90 },
+  [RENDER_ROTATION_180] =
+    { DISPLAY_WIDTH, DISPLAY_HEIGHT, (int16_t)(DISPLAY_WIDTH - 1U), (int16_t)(DISPLAY_HEIGHT - 1U), -1, 0, 0, -1,
+      run_x_rot180, run_y_rot180 },
+  [RENDER_ROTATION_270_CW] =
+    { DISPLAY_HEIGHT, DISPLAY_WIDTH, (int16_t)(DISPLAY_WIDTH - 1U), 0, 0, 1, -1, 0, run_x_rot270, run_y_rot270 },
+};
+
+static const render_xform_t *s_xform = &kRenderXforms[RENDER_ROTATION_270_CW];
+
+/*
+ * Clip a run of `count` bits starting at `*pos` to [0, limit). Returns false
+ * when nothing is left to draw.
+ */
+static bool render_clip_run(int32_t *pos, uint32_t *bits, uint8_t *count, uint16_t limit)
 {
-  if ((rows == NULL) || (out_count == NULL) || (max_rows == 0U))
+  if (*count == 0U)
   {
     return false;
   }
-
-  if (!dirty_any())
+  if (*count < 32U)
   {
-    return false;
+    *bits &= (1UL << *count) - 1UL;
   }
-
-  uint16_t count = 0U;
-  for (uint16_t row = 1U; row <= DISPLAY_HEIGHT; ++row)
+  if (*pos < 0)
   {
-    if (!dirty_is_row(row))
-    {
-      continue;
-    }
-    if (count < max_rows)
-    {
-      rows[count++] = row;
-      dirty_clear_row(row);
-      pack_row(row);
-    }
-    else
+    if (*pos <= -(int32_t)*count)
     {
-      break;
+      return false;
     }
+    *bits >>= (uint32_t)(-*pos);
+    *count = (uint8_t)(*count + *pos);
+    *pos = 0;
+  }
+  if (*pos >= (int32_t)limit)
+  {
+    return false;
+  }
+  if ((*pos + (int32_t)*count) > (int32_t)limit)
+  {
+    *count = (uint8_t)(limit - *pos);
+    *bits &= (1UL << *count) - 1UL;
   }
+  return (*bits != 0U);
+}
 
-  *out_count = count;
-  if (out_full != NULL)
+/* Clip a logical run along +x against the screen and hand it to run_x. */
+static void render_plot_run(int32_t x, int32_t y, uint32_t bits, uint8_t count, const render_ink_t *ink)
+{
+  const render_xform_t *xf = s_xform;
+  if ((y < 0) || (y >= (int32_t)xf->height) || !render_clip_run(&x, &bits, &count, xf->width))
   {
-    *out_full = ((count == DISPLAY_HEIGHT) && !dirty_any());
+    return;
   }
 
-  return (count != 0U);
+  xf->run_x((uint16_t)x, (uint16_t)y, bits, count, ink);
 }
 
-void renderMarkDirtyRows(uint16_t start_row, uint16_t end_row)
+/* Clip a logical run along +y against the screen and hand it to run_y. */
+static void render_plot_run_y(int32_t x, int32_t y, uint32_t bits, uint8_t count, const render_ink_t *ink)
 {
-  mark_dirty_span(start_row, end_row);
-  if (!normalize_span(&start_row, &end_row))
+  const render_xform_t *xf = s_xform;
+  if ((x < 0) || (x >= (int32_t)xf->width) || !render_clip_run(&y, &bits, &count, xf->height))
   {
     return;
   }
+
+  xf->run_y((uint16_t)x, (uint16_t)y, bits, count, ink);
 }
 
-void renderMarkDirtyList(const uint16_t *rows, uint16_t row_count)
+/* Transpose an 8x8 bit matrix: bit j of byte i becomes bit i of byte j. */
+static uint64_t bits_transpose8(uint64_t m)
 {
-  if ((rows == NULL) || (row_count == 0U))
+  uint64_t t;
+  t = (m ^ (m >> 7U)) & 0x00AA00AA00AA00AAULL;
+  m ^= t ^ (t << 7U);
+  t = (m ^ (m >> 14U)) & 0x0000CCCC0000CCCCULL;
+  m ^= t ^ (t << 14U);
+  t = (m ^ (m >> 28U)) & 0x00000000F0F0F0F0ULL;
+  m ^= t ^ (t << 28U);
+  return m;
+}
+
+/*
+ * Glyph atlas. font8x8_basic stores glyphs as LSB-left rows, which is already
+ * run_x order. At 90/270 degrees a glyph column is a physical row, so the
+ * first switch to such a rotation transposes the font once into column bytes
+ * (bit i = glyph row i) and text is drawn with run_y from then on. Mirroring
+ * is handled by the run kernels, so one transposed copy serves both.
+ */
+#define GLYPH_COUNT ((uint32_t)FONT8X8_END_CHAR - (uint32_t)FONT8X8_START_CHAR + 1U)
+
+static uint8_t s_glyph_cols[GLYPH_COUNT][FONT8X8_WIDTH];
+static bool s_glyph_cols_ready = false;
+
+static void glyph_cache_prepare(void)
+{
+  if (s_glyph_cols_ready)
   {
     return;
   }
 
-  for (uint16_t i = 0U; i < row_count; ++i)
+  for (uint32_t i = 0U; i < GLYPH_COUNT; ++i)
   {
-    dirty_set_row(rows[i]);
+    uint64_t tile;
+    memcpy(&tile, font8x8_basic[FONT8X8_START_CHAR + i], sizeof(tile));
+    tile = bits_transpose8(tile);
+    memcpy(s_glyph_cols[i], &tile, sizeof(tile));
   }
+  s_glyph_cols_ready = true;
 }
 
-void renderFill(bool fill)
+static uint32_t glyph_index(char ch)
 {
-  uint8_t pixel = 0U;
-  if (fill)
+  uint8_t code = (uint8_t)ch;
+  if ((code < (uint8_t)FONT8X8_START_CHAR) || (code > (uint8_t)FONT8X8_END_CHAR))
   {
-    pixel |= RENDER_BG_MASK;
+    code = (uint8_t)'?';
   }
-  memset(s_l8_buffer, pixel, sizeof(s_l8_buffer));
-  dirty_set_all();
+  return (uint32_t)code - (uint32_t)FONT8X8_START_CHAR;
 }
 
-void renderInvert(void)
+/* Stretch 8 glyph bits so each one covers `scale` adjacent bits (scale <= 4). */
+static uint32_t glyph_expand(uint8_t bits, uint8_t scale)
 {
-  for (uint32_t i = 0U; i < (uint32_t)DISPLAY_WIDTH * DISPLAY_HEIGHT; ++i)
+  if (scale == 1U)
   {
-    uint8_t pixel = s_l8_buffer[i];
-    pixel = invert_pixel(pixel);
-    s_l8_buffer[i] = (uint8_t)(pixel);
+    return bits;
   }
-  dirty_set_all();
+
+  uint32_t cell = (1UL << scale) - 1UL;
+  uint32_t out = 0U;
+  for (uint32_t i = 0U; bits != 0U; ++i, bits >>= 1U)
+  {
+    if ((bits & 1U) != 0U)
+    {
+      out |= cell << (i * scale);
+    }
+  }
+  return out;
 }
 
-void renderFillRows(uint16_t start_row, uint16_t end_row, bool fill)
+/*
+ * First on-screen coordinate of a scaled glyph that starts at `v`. Scaled
+ * pixels used to be drawn as whole cells that were dropped when their corner
+ * was off the top or left edge, so a cell straddling 0 is skipped, not cut.
+ */
+static int32_t text_cell_floor(int32_t v, uint8_t scale)
 {
-  if (!normalize_logical_span(&start_row, &end_row))
+  if (v >= 0)
   {
-    return;
+    return 0;
   }
+  int32_t part = (-v) % (int32_t)scale;
+  return (part == 0) ? 0 : ((int32_t)scale - part);
+}
 
-  uint16_t width = 0U;
-  uint16_t height = 0U;
-  render_get_logical_dims(&width, &height);
-  (void)height;
-
-  uint8_t base_pixel = 0U;
-  if (fill)
+/* Clear the bits of a run at `pos` that fall before `floor`. */
+static uint32_t text_run_floor(int32_t pos, int32_t floor, uint32_t bits)
+{
+  if (pos >= floor)
   {
-    base_pixel |= RENDER_BG_MASK;
+    return bits;
   }
+  int32_t skip = floor - pos;
+  return (skip >= 32) ? 0U : (bits & ~((1UL << (uint32_t)skip) - 1UL));
+}
 
-  for (uint16_t row = start_row; row <= end_row; ++row)
+/*
+ * Draw `len` glyphs on one line with no wrapping. Row-major rotations stream
+ * each glyph row of the whole line through 32-pixel runs; column-major
+ * rotations emit one run_y per glyph column from the transposed atlas.
+ */
+static void render_text_line(int32_t x, int32_t y, const char *text, uint32_t len, uint8_t scale,
+                             const render_ink_t *ink)
+{
+  const int32_t advance = (int32_t)(FONT8X8_WIDTH + 1U) * (int32_t)scale;
+  const uint8_t glyph_px = (uint8_t)(FONT8X8_WIDTH * scale);
+  const int32_t floor_x = text_cell_floor(x, scale);
+  const int32_t floor_y = text_cell_floor(y, scale);
+
+  if (s_xform->x_step_py != 0)
   {
-    uint16_t y = (uint16_t)(row - 1U);
-    for (uint16_t x = 0U; x < width; ++x)
+    for (uint32_t c = 0U; c < len; ++c)
     {
-      uint16_t px = 0U;
-      uint16_t py = 0U;
-      if (!render_map_xy(x, y, &px, &py))
+      const uint8_t *cols = s_glyph_cols[glyph_index(text[c])];
+      int32_t gx = x + ((int32_t)c * advance);
+      for (uint32_t col = 0U; col < (uint32_t)FONT8X8_WIDTH; ++col)
       {
-        continue;
+        uint32_t bits = glyph_expand(cols[col], scale);
+        if (bits == 0U)
+        {
+          continue;
+        }
+        for (uint32_t k = 0U; k < scale; ++k)
+        {
+          int32_t px = gx + (int32_t)(col * scale + k);
+          if (px >= floor_x)
+          {
+            render_plot_run_y(px, y, text_run_floor(y, floor_y, bits), glyph_px, ink);
+          }
+        }
+      }
+    }
+    return;
+  }
+
+  for (uint32_t row = 0U; row < (uint32_t)FONT8X8_HEIGHT; ++row)
+  {
+    for (uint32_t k = 0U; k < scale; ++k)
+    {
+      int32_t ly = y + (int32_t)(row * scale + k);
+      if ((ly < floor_y) || (ly >= (int32_t)s_xform->height))
+      {
+        continue;
+      }
+
+      int32_t run_x = x;
+      uint64_t acc = 0U;
+      uint32_t fill = 0U;
+      for (uint32_t c = 0U; c < len; ++c)
+      {
+        acc |= (uint64_t)glyph_expand(font8x8_basic[FONT8X8_START_CHAR + glyph_index(text[c])][row], scale)
+               << fill;
+        fill += (uint32_t)advance;
+        while (fill >= 32U)
+        {
+          render_plot_run(run_x, ly, text_run_floor(run_x, floor_x, (uint32_t)acc), 32U, ink);
+          acc >>= 32U;
+          fill -= 32U;
+          run_x += 32;
+        }
+      }
+      if (fill != 0U)
+      {
+        render_plot_run(run_x, ly, text_run_floor(run_x, floor_x, (uint32_t)acc), (uint8_t)fill, ink);
       }
-      render_write_pixel_physical(px, py, base_pixel);
     }
   }
 }
 
-void renderInvertRows(uint16_t start_row, uint16_t end_row)
+static void mark_dirty_span(uint16_t start_row, uint16_t end_row)
 {
-  if (!normalize_logical_span(&start_row, &end_row))
+  if (!normalize_span(&start_row, &end_row))
   {
     return;
   }
 
+  for (uint16_t row = start_row; row <= end_row; ++row)
+  {
+    dirty_force_row(row);
+  }
+}
+
+/*
+ * Pack kernel, chosen at compile time. The portable kernel below is the
+ * reference: it resolves the dirty byte extent of a row, copies it into the
+ * stream and checksums the line it wrote. RENDER_PACK_DSP (the default on
+ * cores with the DSP extension) resolves the whole row, which costs about the
+ * same as the copy, stores it with aligned halfword/word stores merged by
+ * PKHBT and checksums the resolved words directly. Both leave identical
+ * lines and return identical checksums.
+ */
+#ifndef RENDER_PACK_DSP
+  #if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+    #define RENDER_PACK_DSP 1
+  #else
+    #define RENDER_PACK_DSP 0
+  #endif
+#endif
+
+/* The DSP kernel relies on line data sitting at 2 mod 4 in the stream. */
+#if RENDER_PACK_DSP && ((LINE_WIDTH != 18u) || ((LCD_STREAM_LINE_STRIDE % 4u) != 0u))
+  #error "RENDER_PACK_DSP expects 18-byte lines on a 4-byte stream stride"
+#endif
+
+#define ROW_HASH_WORDS ((LINE_WIDTH + 3U) / 4U)
+
+/*
+ * Checksum of one packed line, compared against the line last handed to the
+ * flush. A word-wise multiply/rotate mix over the 18 bytes, read as
+ * little-endian words with the tail zero-padded; a collision only delays a
+ * row until its next change.
+ */
+static uint32_t row_hash_words(const uint32_t *words)
+{
+  uint32_t h = 0x811C9DC5U;
+  for (uint32_t i = 0U; i < ROW_HASH_WORDS; ++i)
+  {
+    h = (h ^ words[i]) * 0x9E3779B1U;
+    h ^= h >> 15U;
+  }
+  return h;
+}
+
+static uint32_t packed_row_hash(const uint8_t *line)
+{
+  uint32_t words[ROW_HASH_WORDS] = { 0U };
+  memcpy(words, line, LINE_WIDTH);
+  return row_hash_words(words);
+}
+
+/*
+ * Hot path: resolve one LCD row 32 pixels at a time.
+ *
+ *   pixel = ui_opaque ? ui_color : (game_opaque ? game_color : bg_color)
+ *
+ * The planes are LSB-first words, which on a little-endian core is exactly
+ * the panel byte order (bit0 of byte 0 is x+0), so bytes lo..hi of the
+ * resolved words are the packed bytes lo..hi of the line.
+ */
+static inline uint32_t pack_resolve_word(const render_row_planes_t *planes, uint32_t w)
+{
+  uint32_t ui = planes->ui_opaque[w];
+  uint32_t game = planes->game_opaque[w];
+  uint32_t below_ui = (game & planes->game_color[w]) | (~game & planes->bg_color[w]);
+  return (ui & planes->ui_color[w]) | (~ui & below_ui);
+}
+
+/*
+ * Both kernels are built when RENDER_PACK_BOTH is defined, so the host test
+ * (Host/test_render_pack.c) can run them side by side.
+ */
+#if !RENDER_PACK_DSP || defined(RENDER_PACK_BOTH)
+/* Portable kernel: copy bytes lo..hi of the resolved row into the line. */
+static uint32_t pack_line_c(const render_row_planes_t *planes, uint8_t *dst, uint32_t lo, uint32_t hi)
+{
+  uint32_t out[PLANE_WORDS];
+  for (uint32_t w = lo >> 2U; w <= (hi >> 2U); ++w)
+  {
+    out[w] = pack_resolve_word(planes, w);
+  }
+
+  memcpy(&dst[lo], (const uint8_t *)out + lo, hi - lo + 1U);
+  return packed_row_hash(dst);
+}
+#endif
+
+#if RENDER_PACK_DSP
+/* DSP kernel: resolve and store the whole line. */
+static uint32_t pack_line_dsp(const render_row_planes_t *planes, uint8_t *dst)
+{
+  uint32_t out[PLANE_WORDS];
+  for (uint32_t w = 0U; w < PLANE_WORDS; ++w)
+  {
+    out[w] = pack_resolve_word(planes, w);
+  }
+
+  /*
+   * Bytes 16..17 end the line; the rest of the last word is padding, zeroed
+   * so `out` doubles as the checksum input. The line starts two bytes into a
+   * word, so store one halfword and then word k as the high half of out[k]
+   * joined with the low half of out[k+1].
+   */
+  out[PLANE_WORDS - 1U] &= 0x0000FFFFU;
+  uint16_t head = (uint16_t)out[0];
+  memcpy(dst, &head, sizeof(head));
+  for (uint32_t w = 0U; w < (PLANE_WORDS - 1U); ++w)
+  {
+    uint32_t word = __PKHBT(out[w] >> 16U, out[w + 1U], 16U);
+    memcpy(&dst[2U + (w * 4U)], &word, sizeof(word));
+  }
+  return row_hash_words(out);
+}
+#endif
+
+/*
+ * Repack the dirty byte extent of one row into the back buffer and return the
+ * checksum of the packed line. A row that was last packed into the other
+ * buffer is repacked whole, since the back buffer's copy predates those
+ * changes.
+ */
+static uint32_t pack_row(uint16_t row)
+{
+  uint32_t row_index = (uint32_t)(row - 1U);
+  uint32_t lo = s_dirty_lo[row_index];
+  uint32_t hi = s_dirty_hi[row_index];
+  uint32_t bit = 1UL << (row_index % 32U);
+  uint32_t *stale = &s_stale_mask[s_pack_index][row_index / 32U];
+  if ((*stale & bit) != 0U)
+  {
+    *stale &= ~bit;
+    lo = 0U;
+    hi = LINE_WIDTH - 1U;
+  }
+  s_stale_mask[s_pack_index ^ 1U][row_index / 32U] |= bit;
+
+  uint8_t *dst = &s_packed_buffer[s_pack_index][LCD_STREAM_DATA_OFFSET(row)];
+  if (lo > hi)
+  {
+    return packed_row_hash(dst);
+  }
+
+#if RENDER_PACK_DSP
+  return pack_line_dsp(&s_planes[row_index], dst);
+#else
+  return pack_line_c(&s_planes[row_index], dst, lo, hi);
+#endif
+}
+
+void renderInit(void)
+{
+  for (uint32_t i = 0U; i < PACKED_BUFFER_COUNT; ++i)
+  {
+    memset(s_packed_buffer[i], 0xFF, sizeof(s_packed_buffer[i]));
+    LCD_StreamInit(s_packed_buffer[i]);
+  }
+  memset(s_stale_mask, 0, sizeof(s_stale_mask));
+  s_pack_index = 0U;
+  s_front_index = 1U;
+  /* LCD_Init() clears the glass to white, which is what the packed buffers hold. */
+  uint32_t white_hash = packed_row_hash(&s_packed_buffer[0][LCD_STREAM_DATA_OFFSET(1U)]);
+  for (uint32_t y = 0U; y < DISPLAY_HEIGHT; ++y)
+  {
+    planes_clear_row(&s_planes[y], false);
+    s_sent_hash[y] = white_hash;
+  }
+  dirty_clear_all();
+  s_rotation = RENDER_ROTATION_270_CW;
+  s_xform = &kRenderXforms[s_rotation];
+  glyph_cache_prepare();
+}
+
+
+void renderSetRotation(render_rotation_t rotation)
+{
+  if ((rotation == RENDER_ROTATION_0) ||
+      (rotation == RENDER_ROTATION_90_CW) ||
+      (rotation == RENDER_ROTATION_180) ||
+      (rotation == RENDER_ROTATION_270_CW))
+  {
+    s_rotation = rotation;
+    s_xform = &kRenderXforms[rotation];
+    if (s_xform->x_step_py != 0)
+    {
+      glyph_cache_prepare();
+    }
+  }
+}
+
+void renderSetFrameDiff(bool enable)
+{
+  s_frame_diff = enable;
+}
+
+render_rotation_t renderGetRotation(void)
+{
+  return s_rotation;
+}
+
+uint16_t renderGetWidth(void)
+{
   uint16_t width = 0U;
   uint16_t height = 0U;
   render_get_logical_dims(&width, &height);
-  (void)height;
+  return width;
+}
 
-  for (uint16_t row = start_row; row <= end_row; ++row)
+uint16_t renderGetHeight(void)
+{
+  uint16_t width = 0U;
+  uint16_t height = 0U;
+  render_get_logical_dims(&width, &height);
+  return height;
+}
+
+const uint8_t *renderGetBuffer(void)
+{
+  return s_packed_buffer[s_front_index];
+}
+
+const uint8_t *renderBeginDirtyRows(void)
+{
+  if (!dirty_any())
   {
-    uint16_t y = (uint16_t)(row - 1U);
-    for (uint16_t x = 0U; x < width; ++x)
+    return NULL;
+  }
+
+  s_take_row = 1U;
+  s_take_count = 0U;
+  return s_packed_buffer[s_pack_index];
+}
+
+uint16_t renderPackDirtyRows(uint16_t *rows, uint16_t max_rows)
+{
+  if (rows == NULL)
+  {
+    return 0U;
+  }
+
+  uint16_t count = 0U;
+  while ((count < max_rows) && (s_take_row <= DISPLAY_HEIGHT))
+  {
+    uint16_t row = s_take_row++;
+    if (!dirty_is_row(row))
     {
-      uint16_t px = 0U;
-      uint16_t py = 0U;
-      if (!render_map_xy(x, y, &px, &py))
-      {
-        continue;
-      }
-      render_invert_pixel_physical(px, py);
+      continue;
     }
+
+    bool forced = dirty_is_forced(row);
+    uint32_t hash = pack_row(row);
+    dirty_clear_row(row);
+
+    if (s_frame_diff && !forced && (hash == s_sent_hash[row - 1U]))
+    {
+      continue;
+    }
+    s_sent_hash[row - 1U] = hash;
+    rows[count++] = row;
   }
+
+  s_take_count += count;
+  return count;
 }
 
-void renderSetPixel(uint16_t x, uint16_t y, render_layer_t layer, render_state_t state)
+void renderEndDirtyRows(void)
+{
+  if (s_take_count != 0U)
+  {
+    s_front_index = s_pack_index;
+    s_pack_index ^= 1U;
+  }
+  s_take_row = DISPLAY_HEIGHT + 1U;
+  s_take_count = 0U;
+}
+
+bool renderTakeDirtyRows(uint16_t *rows, uint16_t max_rows, uint16_t *out_count, bool *out_full)
+{
+  if ((rows == NULL) || (out_count == NULL) || (max_rows == 0U))
+  {
+    return false;
+  }
+
+  if (renderBeginDirtyRows() == NULL)
+  {
+    return false;
+  }
+
+  uint16_t count = renderPackDirtyRows(rows, max_rows);
+  renderEndDirtyRows();
+
+  *out_count = count;
+  if (out_full != NULL)
+  {
+    *out_full = ((count == DISPLAY_HEIGHT) && !dirty_any());
+  }
+
+  return (count != 0U);
+}
+
+void renderMarkDirtyRows(uint16_t start_row, uint16_t end_row)
+{
+  mark_dirty_span(start_row, end_row);
+  if (!normalize_span(&start_row, &end_row))
+  {
+    return;
+  }
+}
+
+void renderMarkDirtyList(const uint16_t *rows, uint16_t row_count)
+{
+  if ((rows == NULL) || (row_count == 0U))
+  {
+    return;
+  }
+
+  for (uint16_t i = 0U; i < row_count; ++i)
+  {
+    dirty_force_row(rows[i]);
+  }
+}
+
+void renderFill(bool fill)
+{
+  for (uint32_t y = 0U; y < DISPLAY_HEIGHT; ++y)
+  {
+    planes_clear_row(&s_planes[y], fill);
+  }
+  dirty_set_all();
+}
+
+void renderClearLayer(render_layer_t layer)
+{
+  for (uint32_t y = 0U; y < DISPLAY_HEIGHT; ++y)
+  {
+    render_row_planes_t *planes = &s_planes[y];
+    switch (layer)
+    {
+      case RENDER_LAYER_UI:
+        memset(planes->ui_opaque, 0, sizeof(planes->ui_opaque));
+        break;
+      case RENDER_LAYER_GAME:
+        memset(planes->game_opaque, 0, sizeof(planes->game_opaque));
+        break;
+      case RENDER_LAYER_BG:
+        memset(planes->bg_color, 0xFF, sizeof(planes->bg_color));
+        break;
+      default:
+        return;
+    }
+  }
+  dirty_set_all();
+}
+
+void renderInvert(void)
+{
+  for (uint32_t y = 0U; y < DISPLAY_HEIGHT; ++y)
+  {
+    for (uint32_t w = 0U; w < PLANE_WORDS; ++w)
+    {
+      planes_invert_word(&s_planes[y], w, 0xFFFFFFFFU);
+    }
+  }
+  dirty_set_all();
+}
+
+void renderFillRows(uint16_t start_row, uint16_t end_row, bool fill)
+{
+  if (!normalize_logical_span(&start_row, &end_row))
+  {
+    return;
+  }
+
+  uint16_t width = 0U;
+  uint16_t height = 0U;
+  render_get_logical_dims(&width, &height);
+  (void)height;
+
+  render_span_rect_logical(0U, (uint16_t)(start_row - 1U), width, (uint16_t)(end_row - start_row + 1U),
+                           fill ? SPAN_OP_CLEAR_BG_BLACK : SPAN_OP_CLEAR_BG_WHITE, NULL);
+}
+
+void renderInvertRows(uint16_t start_row, uint16_t end_row)
+{
+  if (!normalize_logical_span(&start_row, &end_row))
+  {
+    return;
+  }
+
+  uint16_t width = 0U;
+  uint16_t height = 0U;
+  render_get_logical_dims(&width, &height);
+  (void)height;
+
+  render_span_rect_logical(0U, (uint16_t)(start_row - 1U), width, (uint16_t)(end_row - start_row + 1U),
+                           SPAN_OP_INVERT, NULL);
+}
+
+/*
+ * Primitives. Public entry points resolve their ink once; shapes built from
+ * other primitives (rects, thick lines, circles) call the ink-taking helpers
+ * so layer and state are never looked at again per pixel or per span.
+ */
+static void render_set_pixel(uint16_t x, uint16_t y, const render_ink_t *ink)
 {
   uint16_t px = 0U;
   uint16_t py = 0U;
@@ -614,10 +1314,10 @@ void renderSetPixel(uint16_t x, uint16_t y, render_layer_t layer, render_state_t
     return;
   }
 
-  render_set_pixel_physical(px, py, layer, state);
+  render_set_pixel_physical(px, py, ink);
 }
 
-void renderDrawHLine(uint16_t x, uint16_t y, uint16_t length, render_layer_t layer, render_state_t state)
+static void render_hline(uint16_t x, uint16_t y, uint16_t length, const render_ink_t *ink)
 {
   uint16_t width = 0U;
   uint16_t height = 0U;
@@ -629,18 +1329,19 @@ void renderDrawHLine(uint16_t x, uint16_t y, uint16_t length, render_layer_t lay
   }
 
   uint16_t end = (uint16_t)(x + length);
+  if (end <= x)
+  {
+    return;
+  }
   if (end > width)
   {
     end = width;
   }
 
-  for (uint16_t ix = x; ix < end; ++ix)
-  {
-    renderSetPixel(ix, y, layer, state);
-  }
+  render_span_rect_logical(x, y, (uint16_t)(end - x), 1U, SPAN_OP_APPLY, ink);
 }
 
-void renderDrawVLine(uint16_t x, uint16_t y, uint16_t length, render_layer_t layer, render_state_t state)
+static void render_vline(uint16_t x, uint16_t y, uint16_t length, const render_ink_t *ink)
 {
   uint16_t width = 0U;
   uint16_t height = 0U;
@@ -652,15 +1353,16 @@ void renderDrawVLine(uint16_t x, uint16_t y, uint16_t length, render_layer_t lay
   }
 
   uint16_t end = (uint16_t)(y + length);
+  if (end <= y)
+  {
+    return;
+  }
   if (end > height)
   {
     end = height;
   }
 
-  for (uint16_t iy = y; iy < end; ++iy)
-  {
-    renderSetPixel(x, iy, layer, state);
-  }
+  render_span_rect_logical(x, y, 1U, (uint16_t)(end - y), SPAN_OP_APPLY, ink);
 }
 
 void renderFillRect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, render_layer_t layer, render_state_t state)
@@ -676,6 +1378,10 @@ void renderFillRect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, ren
 
   uint16_t end_x = (uint16_t)(x + width);
   uint16_t end_y = (uint16_t)(y + height);
+  if ((end_x <= x) || (end_y <= y))
+  {
+    return;
+  }
   if (end_x > logical_width)
   {
     end_x = logical_width;
@@ -685,11 +1391,8 @@ void renderFillRect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, ren
     end_y = logical_height;
   }
 
-  for (uint16_t iy = y; iy < end_y; ++iy)
-  {
-    uint16_t span = (uint16_t)(end_x - x);
-    renderDrawHLine(x, iy, span, layer, state);
-  }
+  render_span_rect_logical(x, y, (uint16_t)(end_x - x), (uint16_t)(end_y - y), SPAN_OP_APPLY,
+                           render_ink(layer, state));
 }
 
 void renderDrawRect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, render_layer_t layer, render_state_t state)
@@ -699,23 +1402,24 @@ void renderDrawRect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, ren
     return;
   }
 
-  renderDrawHLine(x, y, width, layer, state);
+  const render_ink_t *ink = render_ink(layer, state);
+  render_hline(x, y, width, ink);
   if (height > 1U)
   {
-    renderDrawHLine(x, (uint16_t)(y + height - 1U), width, layer, state);
+    render_hline(x, (uint16_t)(y + height - 1U), width, ink);
   }
 
   if (height > 2U)
   {
-    renderDrawVLine(x, (uint16_t)(y + 1U), (uint16_t)(height - 2U), layer, state);
+    render_vline(x, (uint16_t)(y + 1U), (uint16_t)(height - 2U), ink);
     if (width > 1U)
     {
-      renderDrawVLine((uint16_t)(x + width - 1U), (uint16_t)(y + 1U), (uint16_t)(height - 2U), layer, state);
+      render_vline((uint16_t)(x + width - 1U), (uint16_t)(y + 1U), (uint16_t)(height - 2U), ink);
     }
   }
 }
 
-void renderDrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, render_layer_t layer, render_state_t state)
+static void render_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, const render_ink_t *ink)
 {
   int32_t ix0 = (int32_t)x0;
   int32_t iy0 = (int32_t)y0;
@@ -730,7 +1434,7 @@ void renderDrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, render_l
 
   for (;;)
   {
-    renderSetPixel((uint16_t)ix0, (uint16_t)iy0, layer, state);
+    render_set_pixel((uint16_t)ix0, (uint16_t)iy0, ink);
     if ((ix0 == ix1) && (iy0 == iy1))
     {
       break;
@@ -752,9 +1456,10 @@ void renderDrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, render_l
 void renderDrawLineThick(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t thickness,
                          render_layer_t layer, render_state_t state)
 {
+  const render_ink_t *ink = render_ink(layer, state);
   if (thickness <= 1U)
   {
-    renderDrawLine(x0, y0, x1, y1, layer, state);
+    render_line(x0, y0, x1, y1, ink);
     return;
   }
 
@@ -776,7 +1481,7 @@ void renderDrawLineThick(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uin
   {
     for (;;)
     {
-      renderDrawVLineClamped(ix0, (int32_t)iy0 - r_lo, (int32_t)iy0 + r_hi, layer, state);
+      renderDrawVLineClamped(ix0, (int32_t)iy0 - r_lo, (int32_t)iy0 + r_hi, ink);
       if ((ix0 == ix1) && (iy0 == iy1))
       {
         break;
@@ -798,7 +1503,7 @@ void renderDrawLineThick(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uin
   {
     for (;;)
     {
-      renderDrawHLineClamped((int32_t)ix0 - r_lo, (int32_t)ix0 + r_hi, iy0, layer, state);
+      renderDrawHLineClamped((int32_t)ix0 - r_lo, (int32_t)ix0 + r_hi, iy0, ink);
       if ((ix0 == ix1) && (iy0 == iy1))
       {
         break;
@@ -818,7 +1523,7 @@ void renderDrawLineThick(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uin
   }
 }
 
-static void renderDrawHLineClamped(int32_t x0, int32_t x1, int32_t y, render_layer_t layer, render_state_t state)
+static void renderDrawHLineClamped(int32_t x0, int32_t x1, int32_t y, const render_ink_t *ink)
 {
   uint16_t width = 0U;
   uint16_t height = 0U;
@@ -851,10 +1556,10 @@ static void renderDrawHLineClamped(int32_t x0, int32_t x1, int32_t y, render_lay
   }
 
   uint16_t span = (uint16_t)(x1 - x0 + 1);
-  renderDrawHLine((uint16_t)x0, (uint16_t)y, span, layer, state);
+  render_hline((uint16_t)x0, (uint16_t)y, span, ink);
 }
 
-static void renderDrawVLineClamped(int32_t x, int32_t y0, int32_t y1, render_layer_t layer, render_state_t state)
+static void renderDrawVLineClamped(int32_t x, int32_t y0, int32_t y1, const render_ink_t *ink)
 {
   uint16_t width = 0U;
   uint16_t height = 0U;
@@ -887,319 +1592,821 @@ static void renderDrawVLineClamped(int32_t x, int32_t y0, int32_t y1, render_lay
   }
 
   uint16_t span = (uint16_t)(y1 - y0 + 1);
-  renderDrawVLine((uint16_t)x, (uint16_t)y0, span, layer, state);
+  render_vline((uint16_t)x, (uint16_t)y0, span, ink);
+}
+
+static void render_circle(uint16_t x0, uint16_t y0, uint16_t radius, const render_ink_t *ink)
+{
+  int32_t x = (int32_t)radius;
+  int32_t y = 0;
+  int32_t err = 0;
+
+  while (x >= y)
+  {
+    render_set_pixel((uint16_t)(x0 + x), (uint16_t)(y0 + y), ink);
+    render_set_pixel((uint16_t)(x0 + y), (uint16_t)(y0 + x), ink);
+    render_set_pixel((uint16_t)(x0 - y), (uint16_t)(y0 + x), ink);
+    render_set_pixel((uint16_t)(x0 - x), (uint16_t)(y0 + y), ink);
+    render_set_pixel((uint16_t)(x0 - x), (uint16_t)(y0 - y), ink);
+    render_set_pixel((uint16_t)(x0 - y), (uint16_t)(y0 - x), ink);
+    render_set_pixel((uint16_t)(x0 + y), (uint16_t)(y0 - x), ink);
+    render_set_pixel((uint16_t)(x0 + x), (uint16_t)(y0 - y), ink);
+
+    y++;
+    err += 1 + (2 * y);
+    if ((2 * (err - x)) + 1 > 0)
+    {
+      x--;
+      err += 1 - (2 * x);
+    }
+  }
+}
+
+void renderDrawCircleThick(uint16_t x0, uint16_t y0, uint16_t radius, uint16_t thickness, render_layer_t layer,
+                           render_state_t state)
+{
+  const render_ink_t *ink = render_ink(layer, state);
+  if (thickness <= 1U)
+  {
+    render_circle(x0, y0, radius, ink);
+    return;
+  }
+
+  if (radius == 0U)
+  {
+    render_set_pixel(x0, y0, ink);
+    return;
+  }
+
+  if (thickness >= (uint16_t)(radius + 1U))
+  {
+    render_fill_circle(x0, y0, radius, ink);
+    return;
+  }
+
+  int32_t inner = (int32_t)radius - (int32_t)thickness + 1;
+  if (inner < 0)
+  {
+    inner = 0;
+  }
+
+  for (int32_t r = (int32_t)radius; r >= inner; --r)
+  {
+    render_circle(x0, y0, (uint16_t)r, ink);
+  }
+}
+
+static void render_fill_circle(uint16_t x0, uint16_t y0, uint16_t radius, const render_ink_t *ink)
+{
+  int32_t x = (int32_t)radius;
+  int32_t y = 0;
+  int32_t err = 0;
+
+  while (x >= y)
+  {
+    renderDrawHLineClamped((int32_t)x0 - x, (int32_t)x0 + x, (int32_t)y0 + y, ink);
+    renderDrawHLineClamped((int32_t)x0 - x, (int32_t)x0 + x, (int32_t)y0 - y, ink);
+    renderDrawHLineClamped((int32_t)x0 - y, (int32_t)x0 + y, (int32_t)y0 + x, ink);
+    renderDrawHLineClamped((int32_t)x0 - y, (int32_t)x0 + y, (int32_t)y0 - x, ink);
+
+    y++;
+    err += 1 + (2 * y);
+    if ((2 * (err - x)) + 1 > 0)
+    {
+      x--;
+      err += 1 - (2 * x);
+    }
+  }
+}
+
+void renderSetPixel(uint16_t x, uint16_t y, render_layer_t layer, render_state_t state)
+{
+  render_set_pixel(x, y, render_ink(layer, state));
+}
+
+void renderDrawHLine(uint16_t x, uint16_t y, uint16_t length, render_layer_t layer, render_state_t state)
+{
+  render_hline(x, y, length, render_ink(layer, state));
+}
+
+void renderDrawVLine(uint16_t x, uint16_t y, uint16_t length, render_layer_t layer, render_state_t state)
+{
+  render_vline(x, y, length, render_ink(layer, state));
+}
+
+void renderDrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, render_layer_t layer, render_state_t state)
+{
+  render_line(x0, y0, x1, y1, render_ink(layer, state));
+}
+
+void renderDrawCircle(uint16_t x0, uint16_t y0, uint16_t radius, render_layer_t layer, render_state_t state)
+{
+  render_circle(x0, y0, radius, render_ink(layer, state));
+}
+
+void renderFillCircle(uint16_t x0, uint16_t y0, uint16_t radius, render_layer_t layer, render_state_t state)
+{
+  render_fill_circle(x0, y0, radius, render_ink(layer, state));
+}
+
+/*
+ * Filled convex polygons.
+ *
+ * Vertices are mapped to physical coordinates first, so scanlines are always
+ * physical rows and every span is a masked word run in one row of planes,
+ * whatever the rotation. Each side of the polygon is walked as a chain of
+ * 16.16 fixed-point edges from the top vertex down. Row y covers the pixel
+ * centers x with ceil(x_left) <= x < ceil(x_right), and rows run from the
+ * top vertex up to but not including the bottom one, so faces sharing an edge
+ * neither overlap nor leave gaps.
+ *
+ */
+#define POLY_COORD_LIMIT 8192
+
+typedef struct
+{
+  int32_t x;
+  int32_t y;
+} poly_vertex_t;
+
+typedef struct
+{
+  int32_t x;      /* 16.16 at the current row */
+  int32_t dx;     /* per row */
+  int32_t y_end;  /* first row past this edge */
+  uint32_t v;     /* vertex the edge ends at */
+} poly_edge_t;
+
+/*
+ * Point `e` at the edge of the chain leaving vertex `from` in direction
+ * `step` that covers row y. Returns false when the chain ends above y.
+ */
+static bool poly_edge_setup(poly_edge_t *e, const poly_vertex_t *v, uint32_t n, uint32_t from, uint32_t step,
+                            int32_t y)
+{
+  uint32_t a = from;
+  for (uint32_t guard = 0U; guard < n; ++guard)
+  {
+    uint32_t b = (a + step) % n;
+    if (v[b].y > y)
+    {
+      int32_t dy = v[b].y - v[a].y;
+      e->dx = (int32_t)(((v[b].x - v[a].x) * 65536) / dy);
+      e->x = (int32_t)(((int64_t)v[a].x * 65536) + ((int64_t)(y - v[a].y) * e->dx));
+      e->y_end = v[b].y;
+      e->v = b;
+      return true;
+    }
+    a = b;
+  }
+  return false;
+}
+
+/* Physical clip bounds (inclusive) for an optional logical clip rectangle. */
+static bool render_clip_physical(const render_rect_t *clip, int32_t *cx0, int32_t *cy0, int32_t *cx1, int32_t *cy1)
+{
+  if (clip == NULL)
+  {
+    *cx0 = 0;
+    *cy0 = 0;
+    *cx1 = (int32_t)DISPLAY_WIDTH - 1;
+    *cy1 = (int32_t)DISPLAY_HEIGHT - 1;
+    return true;
+  }
+
+  const render_xform_t *xf = s_xform;
+  int32_t lx0 = (clip->x < 0) ? 0 : clip->x;
+  int32_t ly0 = (clip->y < 0) ? 0 : clip->y;
+  int32_t lx1 = (int32_t)clip->x + (int32_t)clip->width - 1;
+  int32_t ly1 = (int32_t)clip->y + (int32_t)clip->height - 1;
+  if (lx1 >= (int32_t)xf->width)
+  {
+    lx1 = (int32_t)xf->width - 1;
+  }
+  if (ly1 >= (int32_t)xf->height)
+  {
+    ly1 = (int32_t)xf->height - 1;
+  }
+  if ((clip->width == 0U) || (clip->height == 0U) || (lx0 > lx1) || (ly0 > ly1))
+  {
+    return false;
+  }
+
+  uint16_t ax = 0U;
+  uint16_t ay = 0U;
+  uint16_t bx = 0U;
+  uint16_t by = 0U;
+  (void)render_map_xy((uint16_t)lx0, (uint16_t)ly0, &ax, &ay);
+  (void)render_map_xy((uint16_t)lx1, (uint16_t)ly1, &bx, &by);
+  *cx0 = (ax < bx) ? ax : bx;
+  *cx1 = (ax < bx) ? bx : ax;
+  *cy0 = (ay < by) ? ay : by;
+  *cy1 = (ay < by) ? by : ay;
+  return true;
 }
 
-void renderDrawCircle(uint16_t x0, uint16_t y0, uint16_t radius, render_layer_t layer, render_state_t state)
+static void render_fill_polygon(const render_point_t *points, uint8_t count, const render_rect_t *clip,
+                                const render_ink_t *ink)
 {
-  int32_t x = (int32_t)radius;
-  int32_t y = 0;
-  int32_t err = 0;
+  if ((points == NULL) || (count < 3U) || (count > RENDER_POLYGON_MAX_POINTS))
+  {
+    return;
+  }
 
-  while (x >= y)
+  int32_t cx0 = 0;
+  int32_t cy0 = 0;
+  int32_t cx1 = 0;
+  int32_t cy1 = 0;
+  if (!render_clip_physical(clip, &cx0, &cy0, &cx1, &cy1))
   {
-    renderSetPixel((uint16_t)(x0 + x), (uint16_t)(y0 + y), layer, state);
-    renderSetPixel((uint16_t)(x0 + y), (uint16_t)(y0 + x), layer, state);
-    renderSetPixel((uint16_t)(x0 - y), (uint16_t)(y0 + x), layer, state);
-    renderSetPixel((uint16_t)(x0 - x), (uint16_t)(y0 + y), layer, state);
-    renderSetPixel((uint16_t)(x0 - x), (uint16_t)(y0 - y), layer, state);
-    renderSetPixel((uint16_t)(x0 - y), (uint16_t)(y0 - x), layer, state);
-    renderSetPixel((uint16_t)(x0 + y), (uint16_t)(y0 - x), layer, state);
-    renderSetPixel((uint16_t)(x0 + x), (uint16_t)(y0 - y), layer, state);
+    return;
+  }
 
-    y++;
-    err += 1 + (2 * y);
-    if ((2 * (err - x)) + 1 > 0)
+  const render_xform_t *xf = s_xform;
+  poly_vertex_t v[RENDER_POLYGON_MAX_POINTS];
+  uint32_t top = 0U;
+  int32_t y_min = 0;
+  int32_t y_max = 0;
+  for (uint32_t i = 0U; i < count; ++i)
+  {
+    int32_t x = points[i].x;
+    int32_t y = points[i].y;
+    if ((x < -POLY_COORD_LIMIT) || (x >= POLY_COORD_LIMIT) || (y < -POLY_COORD_LIMIT) || (y >= POLY_COORD_LIMIT))
     {
-      x--;
-      err += 1 - (2 * x);
+      return;
+    }
+    v[i].x = xf->origin_x + (x * xf->x_step_px) + (y * xf->y_step_px);
+    v[i].y = xf->origin_y + (x * xf->x_step_py) + (y * xf->y_step_py);
+    if ((i == 0U) || (v[i].y < y_min))
+    {
+      y_min = v[i].y;
+      top = i;
+    }
+    if ((i == 0U) || (v[i].y > y_max))
+    {
+      y_max = v[i].y;
     }
   }
-}
 
-void renderDrawCircleThick(uint16_t x0, uint16_t y0, uint16_t radius, uint16_t thickness, render_layer_t layer,
-                           render_state_t state)
-{
-  if (thickness <= 1U)
+  int32_t y = (y_min > cy0) ? y_min : cy0;
+  int32_t y_end = (y_max <= cy1) ? y_max : (cy1 + 1);
+  if (y >= y_end)
   {
-    renderDrawCircle(x0, y0, radius, layer, state);
     return;
   }
 
-  if (radius == 0U)
+  poly_edge_t left;
+  poly_edge_t right;
+  if (!poly_edge_setup(&left, v, count, top, 1U, y) || !poly_edge_setup(&right, v, count, top, count - 1U, y))
   {
-    renderSetPixel(x0, y0, layer, state);
     return;
   }
 
-  if (thickness >= (uint16_t)(radius + 1U))
+  for (; y < y_end; ++y)
   {
-    renderFillCircle(x0, y0, radius, layer, state);
-    return;
+    if ((y >= left.y_end) && !poly_edge_setup(&left, v, count, left.v, 1U, y))
+    {
+      break;
+    }
+    if ((y >= right.y_end) && !poly_edge_setup(&right, v, count, right.v, count - 1U, y))
+    {
+      break;
+    }
+
+    int32_t xa = (left.x + 0xFFFF) >> 16;
+    int32_t xb = (right.x + 0xFFFF) >> 16;
+    left.x += left.dx;
+    right.x += right.dx;
+    if (xa > xb)
+    {
+      int32_t tmp = xa;
+      xa = xb;
+      xb = tmp;
+    }
+    xb -= 1;
+    if (xa < cx0)
+    {
+      xa = cx0;
+    }
+    if (xb > cx1)
+    {
+      xb = cx1;
+    }
+    if (xa > xb)
+    {
+      continue;
+    }
+
+    render_span_rect_physical((uint16_t)xa, (uint16_t)y, (uint16_t)xb, (uint16_t)y, SPAN_OP_APPLY, ink);
   }
+}
 
-  int32_t inner = (int32_t)radius - (int32_t)thickness + 1;
-  if (inner < 0)
+render_state_t renderDitherState(uint8_t level)
+{
+  if (level == 0U)
   {
-    inner = 0;
+    return RENDER_STATE_WHITE;
   }
-
-  for (int32_t r = (int32_t)radius; r >= inner; --r)
+  if (level >= RENDER_DITHER_LEVELS)
   {
-    renderDrawCircle(x0, y0, (uint16_t)r, layer, state);
+    return RENDER_STATE_BLACK;
   }
+  return RENDER_STATE_DITHER(level);
 }
 
-void renderFillCircle(uint16_t x0, uint16_t y0, uint16_t radius, render_layer_t layer, render_state_t state)
+void renderFillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2,
+                        render_layer_t layer, render_state_t state)
 {
-  int32_t x = (int32_t)radius;
-  int32_t y = 0;
-  int32_t err = 0;
+  const render_point_t points[3] = { { x0, y0 }, { x1, y1 }, { x2, y2 } };
+  render_fill_polygon(points, 3U, NULL, render_ink(layer, state));
+}
 
-  while (x >= y)
-  {
-    renderDrawHLineClamped((int32_t)x0 - x, (int32_t)x0 + x, (int32_t)y0 + y, layer, state);
-    renderDrawHLineClamped((int32_t)x0 - x, (int32_t)x0 + x, (int32_t)y0 - y, layer, state);
-    renderDrawHLineClamped((int32_t)x0 - y, (int32_t)x0 + y, (int32_t)y0 + x, layer, state);
-    renderDrawHLineClamped((int32_t)x0 - y, (int32_t)x0 + y, (int32_t)y0 - x, layer, state);
+void renderFillPolygon(const render_point_t *points, uint8_t count, const render_rect_t *clip,
+                       render_layer_t layer, render_state_t state)
+{
+  render_fill_polygon(points, count, clip, render_ink(layer, state));
+}
 
-    y++;
-    err += 1 + (2 * y);
-    if ((2 * (err - x)) + 1 > 0)
-    {
-      x--;
-      err += 1 - (2 * x);
-    }
-  }
+void renderFillPolygonDither(const render_point_t *points, uint8_t count, const render_rect_t *clip,
+                             render_layer_t layer, uint8_t level)
+{
+  render_fill_polygon(points, count, clip, render_ink(layer, renderDitherState(level)));
 }
 
-void renderDrawChar(uint16_t x, uint16_t y, char ch, render_layer_t layer, render_state_t fg)
+/*
+ * Layer scrolling.
+ *
+ * Every rotation maps a logical translation onto a physical one, so moving a
+ * layer's content is a copy between physical rows for the y offset and a
+ * multiword shift for the x offset, applied to that layer's planes only and
+ * masked to the physical columns of the rectangle.
+ */
+static void plane_shift_row(const uint32_t *src, uint32_t *dst, int32_t shift)
 {
-  uint8_t code = (uint8_t)ch;
-  if ((code < (uint8_t)FONT8X8_START_CHAR) || (code > (uint8_t)FONT8X8_END_CHAR))
+  for (uint32_t w = 0U; w < PLANE_WORDS; ++w)
   {
-    code = (uint8_t)'?';
+    /* Source bit of dst bit 32*w, biased by PLANE_WORDS words to stay unsigned. */
+    uint32_t base = (uint32_t)((int32_t)((w + PLANE_WORDS) * 32U) - shift);
+    uint32_t sw = base >> 5U;
+    uint32_t sb = base & 31U;
+    uint32_t lo = ((sw >= PLANE_WORDS) && (sw < (2U * PLANE_WORDS))) ? src[sw - PLANE_WORDS] : 0U;
+    uint32_t hi = (((sw + 1U) >= PLANE_WORDS) && ((sw + 1U) < (2U * PLANE_WORDS))) ? src[sw + 1U - PLANE_WORDS] : 0U;
+    dst[w] = (sb == 0U) ? lo : ((lo >> sb) | (hi << (32U - sb)));
   }
+}
+
+static void render_scroll_plane(size_t plane, int32_t y0, int32_t y1, int32_t pdx, int32_t pdy,
+                                const uint32_t *mask)
+{
+  int32_t first = (pdy > 0) ? y1 : y0;
+  int32_t last = (pdy > 0) ? (y0 + pdy) : (y1 + pdy);
+  int32_t step = (pdy > 0) ? -1 : 1;
 
-  const uint8_t *glyph = font8x8_basic[code];
-  for (uint16_t row = 0U; row < (uint16_t)FONT8X8_HEIGHT; ++row)
+  for (int32_t y = first; y != (last + step); y += step)
   {
-    uint8_t bits = glyph[row];
-    for (uint16_t col = 0U; col < (uint16_t)FONT8X8_WIDTH; ++col)
+    const uint32_t *src = (const uint32_t *)((const uint8_t *)&s_planes[y - pdy] + plane);
+    uint32_t *dst = (uint32_t *)((uint8_t *)&s_planes[y] + plane);
+    uint32_t shifted[PLANE_WORDS];
+
+    plane_shift_row(src, shifted, pdx);
+    for (uint32_t w = 0U; w < PLANE_WORDS; ++w)
     {
-      if ((bits & (uint8_t)(1U << col)) != 0U)
-      {
-        renderSetPixel((uint16_t)(x + col), (uint16_t)(y + row), layer, fg);
-      }
+      dst[w] = (shifted[w] & mask[w]) | (dst[w] & ~mask[w]);
     }
   }
 }
 
-void renderDrawText(uint16_t x, uint16_t y, const char *text, render_layer_t layer, render_state_t fg)
+void renderScrollLayer(const render_rect_t *rect, int16_t dx, int16_t dy, render_layer_t layer)
 {
-  if (text == NULL)
+  int32_t x0 = 0;
+  int32_t y0 = 0;
+  int32_t x1 = 0;
+  int32_t y1 = 0;
+  if (!render_clip_physical(rect, &x0, &y0, &x1, &y1))
   {
     return;
   }
 
-  uint16_t width = renderGetWidth();
-  uint16_t height = renderGetHeight();
-  if ((width == 0U) || (height == 0U))
+  const render_xform_t *xf = s_xform;
+  int32_t pdx = ((int32_t)dx * xf->x_step_px) + ((int32_t)dy * xf->y_step_px);
+  int32_t pdy = ((int32_t)dx * xf->x_step_py) + ((int32_t)dy * xf->y_step_py);
+  int32_t adx = (pdx < 0) ? -pdx : pdx;
+  int32_t ady = (pdy < 0) ? -pdy : pdy;
+  if (((pdx == 0) && (pdy == 0)) || (adx > (x1 - x0)) || (ady > (y1 - y0)))
   {
+    /* Nothing moves, or nothing that stays inside the rectangle survives. */
     return;
   }
 
-  uint16_t cursor_x = x;
-  uint16_t cursor_y = y;
-  uint16_t advance_x = (uint16_t)(FONT8X8_WIDTH + 1U);
-  uint16_t advance_y = (uint16_t)(FONT8X8_HEIGHT + 1U);
-
-  for (const char *ptr = text; *ptr != '\0'; ++ptr)
+  uint32_t mask[PLANE_WORDS];
+  for (uint32_t w = 0U; w < PLANE_WORDS; ++w)
   {
-    if (*ptr == '\n')
+    int32_t lo = x0 - (int32_t)(w * 32U);
+    int32_t hi = x1 - (int32_t)(w * 32U);
+    uint32_t m = (hi < 0) ? 0U : ((hi >= 31) ? 0xFFFFFFFFU : (0xFFFFFFFFU >> (31U - (uint32_t)hi)));
+    if (lo > 31)
     {
-      cursor_x = x;
-      cursor_y = (uint16_t)(cursor_y + advance_y);
-      if (cursor_y >= height)
-      {
-        break;
-      }
-      continue;
+      m = 0U;
     }
-
-    renderDrawChar(cursor_x, cursor_y, *ptr, layer, fg);
-    cursor_x = (uint16_t)(cursor_x + advance_x);
-    if ((uint16_t)(cursor_x + FONT8X8_WIDTH) > width)
+    else if (lo > 0)
     {
-      cursor_x = x;
-      cursor_y = (uint16_t)(cursor_y + advance_y);
-      if (cursor_y >= height)
-      {
-        break;
-      }
+      m &= 0xFFFFFFFFU << (uint32_t)lo;
     }
+    mask[w] = m;
+  }
+
+  switch (layer)
+  {
+    case RENDER_LAYER_UI:
+      render_scroll_plane(offsetof(render_row_planes_t, ui_opaque), y0, y1, pdx, pdy, mask);
+      render_scroll_plane(offsetof(render_row_planes_t, ui_color), y0, y1, pdx, pdy, mask);
+      break;
+    case RENDER_LAYER_GAME:
+      render_scroll_plane(offsetof(render_row_planes_t, game_opaque), y0, y1, pdx, pdy, mask);
+      render_scroll_plane(offsetof(render_row_planes_t, game_color), y0, y1, pdx, pdy, mask);
+      break;
+    case RENDER_LAYER_BG:
+      render_scroll_plane(offsetof(render_row_planes_t, bg_color), y0, y1, pdx, pdy, mask);
+      break;
+    default:
+      return;
   }
+
+  dirty_set_physical_rect((uint16_t)x0, (uint16_t)y0, (uint16_t)x1, (uint16_t)y1);
 }
 
-void renderBlit1bpp(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *data,
-                    uint16_t stride_bytes, render_layer_t layer, render_state_t fg)
+/*
+ * 1bpp blitter.
+ *
+ * The source rectangle is clipped once, then read a byte at a time: up to
+ * five source bytes are merged and shifted into one 32-pixel run, so the
+ * source bit offset never has to be byte aligned. At 0/180 degrees each run
+ * is a logical row handed to run_x. At 90/270 degrees logical columns are
+ * physical rows, so 8x8 tiles are transposed and handed to run_y as runs of
+ * up to 32 rows, which keeps the plane writes word-wide in every rotation.
+ */
+static uint32_t blit_fetch_bits(const uint8_t *row, uint32_t col, uint32_t count, bool msb_first)
 {
-  if ((data == NULL) || (width == 0U) || (height == 0U))
+  const uint8_t *src = &row[col >> 3U];
+  uint32_t shift = col & 7U;
+  uint32_t bits;
+
+  if ((shift == 0U) && (count == 32U))
   {
-    return;
+    memcpy(&bits, src, sizeof(bits));
+    return msb_first ? __RBIT(__REV(bits)) : bits;
   }
 
-  if (stride_bytes == 0U)
+  uint32_t byte_count = (shift + count + 7U) >> 3U;
+  uint64_t acc = 0U;
+  for (uint32_t i = 0U; i < byte_count; ++i)
+  {
+    uint32_t b = src[i];
+    if (msb_first)
+    {
+      b = __RBIT(b) >> 24U;
+    }
+    acc |= (uint64_t)b << (8U * i);
+  }
+
+  bits = (uint32_t)(acc >> shift);
+  if (count < 32U)
   {
-    stride_bytes = (uint16_t)((width + 7U) / 8U);
+    bits &= (1UL << count) - 1UL;
   }
+  return bits;
+}
+
+static void blit_emit(render_run_fn run, uint16_t x, uint16_t y, uint32_t bits, uint8_t count,
+                      const render_ink_t *fg, const render_ink_t *bg, render_blit_mode_t mode)
+{
+  uint32_t count_mask = (count < 32U) ? ((1UL << count) - 1UL) : 0xFFFFFFFFU;
 
-  /* Sprite data is LSB-left; bit0 is the leftmost pixel in each byte. */
-  for (uint16_t row = 0U; row < height; ++row)
+  if (mode == RENDER_BLIT_INVERTED)
+  {
+    bits = ~bits & count_mask;
+  }
+  if (bits != 0U)
+  {
+    run(x, y, bits, count, fg);
+  }
+  if (mode == RENDER_BLIT_OPAQUE)
   {
-    const uint8_t *row_ptr = &data[row * stride_bytes];
-    for (uint16_t col = 0U; col < width; ++col)
+    uint32_t rest = ~bits & count_mask;
+    if (rest != 0U)
     {
-      uint8_t byte = row_ptr[col >> 3U];
-      if ((byte & (uint8_t)(1U << (col & 7U))) != 0U)
-      {
-        renderSetPixel((uint16_t)(x + col), (uint16_t)(y + row), layer, fg);
-      }
+      run(x, y, rest, count, bg);
     }
   }
 }
 
-void renderBlit1bppMsb(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *data,
-                       uint16_t stride_bytes, render_layer_t layer, render_state_t fg)
+static void render_blit(int32_t x, int32_t y, uint16_t width, uint16_t height, const uint8_t *data,
+                        uint16_t stride_bytes, uint16_t src_x, bool msb_first, render_layer_t layer,
+                        render_state_t fg, render_blit_mode_t mode)
 {
   if ((data == NULL) || (width == 0U) || (height == 0U))
   {
     return;
   }
-
   if (stride_bytes == 0U)
   {
-    stride_bytes = (uint16_t)((width + 7U) / 8U);
+    stride_bytes = (uint16_t)((src_x + width + 7U) / 8U);
   }
 
-  /* Sprite data is MSB-left; bit7 is the leftmost pixel in each byte. */
-  for (uint16_t row = 0U; row < height; ++row)
+  /* Opaque blits paint clear bits in the opposite color. */
+  render_state_t bg = RENDER_STATE_TRANSPARENT;
+  if (mode == RENDER_BLIT_OPAQUE)
   {
-    const uint8_t *row_ptr = &data[row * stride_bytes];
-    for (uint16_t col = 0U; col < width; ++col)
+    if (fg == RENDER_STATE_BLACK)
     {
-      uint8_t byte = row_ptr[col >> 3U];
-      if ((byte & (uint8_t)(0x80U >> (col & 7U))) != 0U)
-      {
-        renderSetPixel((uint16_t)(x + col), (uint16_t)(y + row), layer, fg);
-      }
+      bg = RENDER_STATE_WHITE;
+    }
+    else if (fg == RENDER_STATE_WHITE)
+    {
+      bg = RENDER_STATE_BLACK;
+    }
+    else
+    {
+      mode = RENDER_BLIT_TRANSPARENT;
     }
   }
-}
+  const render_ink_t *fg_ink = render_ink(layer, fg);
+  const render_ink_t *bg_ink = render_ink(layer, bg);
 
-
-// display_renderer.c
-
-void renderDrawCharScaled(uint16_t x, uint16_t y, char ch, uint8_t scale, render_layer_t layer, render_state_t fg)
-{
-  if (scale == 0U)
+  const render_xform_t *xf = s_xform;
+  int32_t x0 = (x < 0) ? 0 : x;
+  int32_t y0 = (y < 0) ? 0 : y;
+  int32_t x1 = x + (int32_t)width;
+  int32_t y1 = y + (int32_t)height;
+  if (x1 > (int32_t)xf->width)
   {
-    scale = 1U;
+    x1 = (int32_t)xf->width;
   }
-  if (scale > 4U)
+  if (y1 > (int32_t)xf->height)
   {
-    scale = 4U;
+    y1 = (int32_t)xf->height;
   }
-
-  if (scale == 1U)
+  if ((x0 >= x1) || (y0 >= y1))
   {
-    renderDrawChar(x, y, ch, layer, fg);
     return;
   }
 
-  uint8_t code = (uint8_t)ch;
-  if ((code < (uint8_t)FONT8X8_START_CHAR) || (code > (uint8_t)FONT8X8_END_CHAR))
+  uint32_t col_base = (uint32_t)src_x + (uint32_t)(x0 - x);
+
+  if (xf->x_step_py == 0)
   {
-    code = (uint8_t)'?';
+    /* Logical rows are physical rows. */
+    for (int32_t ly = y0; ly < y1; ++ly)
+    {
+      const uint8_t *row = &data[(uint32_t)(ly - y) * stride_bytes];
+      for (int32_t lx = x0; lx < x1; lx += 32)
+      {
+        uint32_t count = (uint32_t)(x1 - lx);
+        if (count > 32U)
+        {
+          count = 32U;
+        }
+        uint32_t bits = blit_fetch_bits(row, col_base + (uint32_t)(lx - x0), count, msb_first);
+        blit_emit(xf->run_x, (uint16_t)lx, (uint16_t)ly, bits, (uint8_t)count, fg_ink, bg_ink, mode);
+      }
+    }
+    return;
   }
 
-  const uint8_t *glyph = font8x8_basic[code];
-
-  for (uint16_t row = 0U; row < (uint16_t)FONT8X8_HEIGHT; ++row)
+  /* Logical columns are physical rows: transpose bands of up to 32 rows. */
+  for (int32_t band_y = y0; band_y < y1; band_y += 32)
   {
-    uint8_t bits = glyph[row];
+    uint32_t rows = (uint32_t)(y1 - band_y);
+    if (rows > 32U)
+    {
+      rows = 32U;
+    }
 
-    for (uint16_t col = 0U; col < (uint16_t)FONT8X8_WIDTH; ++col)
+    for (int32_t lx = x0; lx < x1; lx += 8)
     {
-      if ((bits & (uint8_t)(1U << col)) != 0U)
+      uint32_t cols = (uint32_t)(x1 - lx);
+      if (cols > 8U)
+      {
+        cols = 8U;
+      }
+      uint32_t col = col_base + (uint32_t)(lx - x0);
+
+      uint32_t col_bits[8] = { 0U };
+      for (uint32_t r0 = 0U; r0 < rows; r0 += 8U)
+      {
+        uint32_t tile_rows = rows - r0;
+        if (tile_rows > 8U)
+        {
+          tile_rows = 8U;
+        }
+
+        uint64_t tile = 0U;
+        const uint8_t *row = &data[(uint32_t)(band_y - y + (int32_t)r0) * stride_bytes];
+        for (uint32_t i = 0U; i < tile_rows; ++i, row += stride_bytes)
+        {
+          tile |= (uint64_t)blit_fetch_bits(row, col, cols, msb_first) << (8U * i);
+        }
+        tile = bits_transpose8(tile);
+
+        for (uint32_t j = 0U; j < cols; ++j)
+        {
+          col_bits[j] |= (uint32_t)((tile >> (8U * j)) & 0xFFU) << r0;
+        }
+      }
+
+      for (uint32_t j = 0U; j < cols; ++j)
       {
-        uint16_t px = (uint16_t)(x + (uint16_t)(col * scale));
-        uint16_t py = (uint16_t)(y + (uint16_t)(row * scale));
-        renderFillRect(px, py, (uint16_t)scale, (uint16_t)scale, layer, fg);
+        blit_emit(xf->run_y, (uint16_t)(lx + (int32_t)j), (uint16_t)band_y, col_bits[j], (uint8_t)rows, fg_ink,
+                  bg_ink, mode);
       }
     }
   }
 }
 
-void renderDrawTextScaled(uint16_t x, uint16_t y, const char *text, uint8_t scale, render_layer_t layer, render_state_t fg)
+void renderBlit1bpp(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *data,
+                    uint16_t stride_bytes, render_layer_t layer, render_state_t fg)
 {
-  if (text == NULL)
-  {
-    return;
-  }
+  /*
+   * Sprite data is LSB-left; bit0 is the leftmost pixel in each byte.
+   * Coordinates just below zero arrive wrapped (65530 for -6) and have always
+   * drawn the on-screen part, so read them back as signed.
+   */
+  render_blit((int32_t)(int16_t)x, (int32_t)(int16_t)y, width, height, data, stride_bytes, 0U, false, layer, fg,
+              RENDER_BLIT_TRANSPARENT);
+}
 
-  if (scale == 0U)
-  {
-    scale = 1U;
-  }
-  if (scale > 4U)
-  {
-    scale = 4U;
-  }
+void renderBlit1bppMsb(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *data,
+                       uint16_t stride_bytes, render_layer_t layer, render_state_t fg)
+{
+  /* Sprite data is MSB-left; bit7 is the leftmost pixel in each byte. Wrapped coordinates as above. */
+  render_blit((int32_t)(int16_t)x, (int32_t)(int16_t)y, width, height, data, stride_bytes, 0U, true, layer, fg,
+              RENDER_BLIT_TRANSPARENT);
+}
 
-  if (scale == 1U)
+void renderBlit1bppEx(int16_t x, int16_t y, uint16_t width, uint16_t height, const uint8_t *data,
+                      uint16_t stride_bytes, uint16_t src_x, render_layer_t layer, render_state_t fg,
+                      render_blit_mode_t mode)
+{
+  render_blit(x, y, width, height, data, stride_bytes, src_x, false, layer, fg, mode);
+}
+
+void renderBlit1bppMsbEx(int16_t x, int16_t y, uint16_t width, uint16_t height, const uint8_t *data,
+                         uint16_t stride_bytes, uint16_t src_x, render_layer_t layer, render_state_t fg,
+                         render_blit_mode_t mode)
+{
+  render_blit(x, y, width, height, data, stride_bytes, src_x, true, layer, fg, mode);
+}
+
+
+static uint8_t text_clamp_scale(uint8_t scale)
+{
+  if (scale == 0U)
   {
-    renderDrawText(x, y, text, layer, fg);
-    return;
+    return 1U;
   }
+  return (scale > 4U) ? 4U : scale;
+}
 
+/*
+ * Lay text out with the historical cursor rules: '\n' and running past the
+ * right edge start a new line, and layout stops once a line starts below the
+ * screen. Consecutive glyphs on one line are handed to render_text_line() as
+ * a single segment. Cursors are 16-bit and wrap, so a position just below
+ * zero is handed on as the negative coordinate it stands for.
+ */
+static void render_text_layout(uint16_t x, uint16_t y, const char *text, uint8_t scale, const render_ink_t *ink)
+{
   uint16_t width = renderGetWidth();
   uint16_t height = renderGetHeight();
-  if ((width == 0U) || (height == 0U))
+  if ((text == NULL) || (width == 0U) || (height == 0U))
   {
     return;
   }
 
-  uint16_t cursor_x = x;
-  uint16_t cursor_y = y;
-
   uint16_t advance_x = (uint16_t)(((uint16_t)FONT8X8_WIDTH + 1U) * (uint16_t)scale);
   uint16_t advance_y = (uint16_t)(((uint16_t)FONT8X8_HEIGHT + 1U) * (uint16_t)scale);
+  uint16_t glyph_w = (uint16_t)((uint16_t)FONT8X8_WIDTH * (uint16_t)scale);
+
+  uint16_t cursor_x = x;
+  uint16_t cursor_y = y;
+  uint16_t seg_x = x;
+  const char *seg = text;
+  uint32_t seg_len = 0U;
 
   for (const char *ptr = text; *ptr != '\0'; ++ptr)
   {
     if (*ptr == '\n')
     {
+      render_text_line((int16_t)seg_x, (int16_t)cursor_y, seg, seg_len, scale, ink);
+      seg = ptr + 1;
+      seg_len = 0U;
+      seg_x = x;
       cursor_x = x;
       cursor_y = (uint16_t)(cursor_y + advance_y);
       if (cursor_y >= height)
       {
-        break;
+        return;
       }
       continue;
     }
 
-    renderDrawCharScaled(cursor_x, cursor_y, *ptr, scale, layer, fg);
-
-    cursor_x = (uint16_t)(cursor_x + advance_x);
-    if ((uint16_t)(cursor_x + ((uint16_t)FONT8X8_WIDTH * (uint16_t)scale)) > width)
+    ++seg_len;
+    uint16_t next_x = (uint16_t)(cursor_x + advance_x);
+    if ((uint16_t)(next_x + glyph_w) > width)
     {
+      render_text_line((int16_t)seg_x, (int16_t)cursor_y, seg, seg_len, scale, ink);
+      seg = ptr + 1;
+      seg_len = 0U;
+      seg_x = x;
       cursor_x = x;
       cursor_y = (uint16_t)(cursor_y + advance_y);
       if (cursor_y >= height)
       {
-        break;
+        return;
+      }
+      continue;
+    }
+    if (next_x < cursor_x)
+    {
+      /* The 16-bit cursor wrapped; start a new segment at the wrapped x. */
+      render_text_line((int16_t)seg_x, (int16_t)cursor_y, seg, seg_len, scale, ink);
+      seg = ptr + 1;
+      seg_len = 0U;
+      seg_x = next_x;
+    }
+    cursor_x = next_x;
+  }
+
+  render_text_line((int16_t)seg_x, (int16_t)cursor_y, seg, seg_len, scale, ink);
+}
+
+void renderDrawChar(uint16_t x, uint16_t y, char ch, render_layer_t layer, render_state_t fg)
+{
+  render_text_line((int16_t)x, (int16_t)y, &ch, 1U, 1U, render_ink(layer, fg));
+}
+
+void renderDrawText(uint16_t x, uint16_t y, const char *text, render_layer_t layer, render_state_t fg)
+{
+  render_text_layout(x, y, text, 1U, render_ink(layer, fg));
+}
+
+void renderDrawCharScaled(uint16_t x, uint16_t y, char ch, uint8_t scale, render_layer_t layer, render_state_t fg)
+{
+  render_text_line((int16_t)x, (int16_t)y, &ch, 1U, text_clamp_scale(scale), render_ink(layer, fg));
+}
+
+void renderDrawTextScaled(uint16_t x, uint16_t y, const char *text, uint8_t scale, render_layer_t layer, render_state_t fg)
+{
+  render_text_layout(x, y, text, text_clamp_scale(scale), render_ink(layer, fg));
+}
+
+void renderMeasureText(const char *text, uint8_t scale, uint16_t *out_width, uint16_t *out_height)
+{
+  uint32_t max_len = 0U;
+  uint32_t lines = 0U;
+
+  if (text != NULL)
+  {
+    uint32_t len = 0U;
+    lines = 1U;
+    for (const char *ptr = text; *ptr != '\0'; ++ptr)
+    {
+      if (*ptr == '\n')
+      {
+        ++lines;
+        len = 0U;
+        continue;
+      }
+      ++len;
+      if (len > max_len)
+      {
+        max_len = len;
       }
     }
+    if (max_len == 0U)
+    {
+      lines = 0U;
+    }
+  }
+
+  scale = text_clamp_scale(scale);
+  uint32_t advance_x = ((uint32_t)FONT8X8_WIDTH + 1U) * scale;
+  uint32_t advance_y = ((uint32_t)FONT8X8_HEIGHT + 1U) * scale;
+
+  /* Trailing inter-glyph and inter-line spacing is not part of the extent. */
+  if (out_width != NULL)
+  {
+    *out_width = (max_len == 0U) ? 0U : (uint16_t)((max_len * advance_x) - scale);
+  }
+  if (out_height != NULL)
+  {
+    *out_height = (lines == 0U) ? 0U : (uint16_t)((lines * advance_y) - scale);
   }
 }
+
+uint16_t renderTextWidth(const char *text)
+{
+  uint16_t width = 0U;
+  renderMeasureText(text, 1U, &width, NULL);
+  return width;
+}
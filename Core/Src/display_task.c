@@ -2,8 +2,11 @@
 
 #include "LS013B7DH05.h"
 #include "display_renderer.h"
+#include "render_bench.h"
+#include "render_check.h"
 #include "render_demo.h"
 #include "app_freertos.h"
+#include "game_task.h"
 #include "main.h"
 #include "power_task.h"
 
@@ -11,12 +14,26 @@ extern SPI_HandleTypeDef hspi3;
 
 static LS013B7DH05 s_display;
 static volatile bool s_display_busy = false;
-static uint16_t s_rows[DISPLAY_HEIGHT];
+static bool s_display_stalled = false;
+/* Row lists for the in-flight transfer and the one being prepared. */
+static uint16_t s_rows[2][DISPLAY_HEIGHT];
+static uint16_t s_row_count[2];
+static uint8_t s_inflight_slot = 0U;
 static const uint32_t kDisplayFlagDmaDone = (1UL << 0U);
 static const uint32_t kDisplayFlagDmaError = (1UL << 1U);
 static const uint32_t kDisplayFlushTimeoutMs = 200U;
+/* Rows packed per step of a streaming flush (20 wire bytes each). */
+static const uint16_t kDisplayStreamBatchRows = 8U;
 
-static void display_handle_cmd(app_display_cmd_t cmd)
+/* Core cycles to microseconds at the current (perf-mode dependent) clock. */
+static uint32_t display_cycles_to_us(uint32_t cycles)
+{
+  uint32_t mhz = SystemCoreClock / 1000000U;
+  return (mhz != 0U) ? (cycles / mhz) : 0U;
+}
+
+/* Returns true when the command drew a demo frame. */
+static bool display_handle_cmd(app_display_cmd_t cmd)
 {
   switch (cmd)
   {
@@ -25,87 +42,181 @@ static void display_handle_cmd(app_display_cmd_t cmd)
       break;
     case APP_DISPLAY_CMD_RENDER_DEMO:
       render_demo_draw();
-      break;
+      return true;
     case APP_DISPLAY_CMD_INVALIDATE:
       break;
     default:
       break;
   }
+  return false;
 }
 
-static void display_flush_dirty(void)
+/*
+ * Wait up to `timeout_ms` for the in-flight transfer. Rows it carried are
+ * marked dirty again unless it reported success. Returns false while the
+ * transfer is still running.
+ */
+static bool display_complete_transfer(uint32_t timeout_ms)
 {
-  if (s_display_busy)
+  if (!s_display_busy)
+  {
+    return true;
+  }
+
+  int32_t flags = (int32_t)osThreadFlagsWait(kDisplayFlagDmaDone | kDisplayFlagDmaError,
+                                             osFlagsWaitAny,
+                                             timeout_ms);
+  if ((flags < 0) && !LCD_FlushDMA_IsDone())
   {
-    if (LCD_FlushDMA_IsDone())
+    return false;
+  }
+
+  s_display_busy = false;
+  s_display_stalled = false;
+  if ((flags < 0) || ((flags & (int32_t)kDisplayFlagDmaError) != 0))
+  {
+    renderMarkDirtyList(s_rows[s_inflight_slot], s_row_count[s_inflight_slot]);
+  }
+  return true;
+}
+
+/*
+ * Streaming flush for an idle bus: rows are handed to the driver a batch at
+ * a time as they are packed, so the first rows are on the wire while the
+ * rest of the frame is still being packed.
+ */
+static void display_stream_dirty(void)
+{
+  uint8_t slot = (uint8_t)(s_inflight_slot ^ 1U);
+  uint16_t *rows = s_rows[slot];
+  const uint8_t *buf = renderBeginDirtyRows();
+  if (buf == NULL)
+  {
+    return;
+  }
+
+  uint16_t count = 0U;
+  bool started = false;
+  HAL_StatusTypeDef st = HAL_OK;
+  while (count < DISPLAY_HEIGHT)
+  {
+    uint16_t batch = (uint16_t)(DISPLAY_HEIGHT - count);
+    if (batch > kDisplayStreamBatchRows)
     {
-      s_display_busy = false;
+      batch = kDisplayStreamBatchRows;
     }
-    else
+    uint16_t n = renderPackDirtyRows(&rows[count], batch);
+    if (n == 0U)
     {
-      return;
+      break;
     }
+
+    if ((st == HAL_OK) && !started)
+    {
+      (void)osThreadFlagsClear(kDisplayFlagDmaDone | kDisplayFlagDmaError);
+      st = LCD_StreamBegin_DMA(&s_display, buf);
+      started = (st == HAL_OK);
+    }
+    if (st == HAL_OK)
+    {
+      st = LCD_StreamRows_DMA(&s_display, &rows[count], n);
+    }
+    count += n;
   }
+  renderEndDirtyRows();
 
-  uint16_t count = 0U;
-  bool full = false;
-  if (!renderTakeDirtyRows(s_rows, DISPLAY_HEIGHT, &count, &full))
+  if (started && (st == HAL_OK))
+  {
+    st = LCD_StreamEnd_DMA(&s_display);
+  }
+  if (count == 0U)
   {
     return;
   }
-
-  const uint8_t *buf = renderGetBuffer();
-  if (buf == NULL)
+  if (!started || (st != HAL_OK))
   {
-    renderMarkDirtyList(s_rows, count);
+    /* A stream that failed part way finishes on its own; resend it all. */
+    renderMarkDirtyList(rows, count);
     return;
   }
 
-  (void)osThreadFlagsClear(kDisplayFlagDmaDone | kDisplayFlagDmaError);
+  s_row_count[slot] = count;
+  s_inflight_slot = slot;
   s_display_busy = true;
-  HAL_StatusTypeDef st = HAL_ERROR;
-  if (full)
+}
+
+/*
+ * Pipelined flush: while frame N is still on the wire, frame N+1 is packed
+ * (into the renderer's other packed buffer) and staged (into the driver's
+ * idle DMA slot). Only then does the task wait for N to finish, start N+1
+ * and return to compose the next frame without waiting for it. With the bus
+ * already idle there is nothing to hide the packing behind, so it streams.
+ */
+static void display_flush_dirty(void)
+{
+  /* A transfer that outlived its wait must drain before a buffer is reused. */
+  if (s_display_stalled && !display_complete_transfer(0U))
   {
-    st = LCD_FlushAll_DMA(&s_display, buf);
+    return;
   }
-  else
+
+  if (!s_display_busy)
   {
-    st = LCD_FlushRows_DMA(&s_display, buf, s_rows, count);
+    display_stream_dirty();
+    return;
   }
 
-  if (st != HAL_OK)
+  uint8_t slot = (uint8_t)(s_inflight_slot ^ 1U);
+  uint16_t *rows = s_rows[slot];
+  uint16_t count = 0U;
+  bool full = false;
+  if (!renderTakeDirtyRows(rows, DISPLAY_HEIGHT, &count, &full))
   {
-    s_display_busy = false;
-    renderMarkDirtyList(s_rows, count);
     return;
   }
 
-  int32_t flags = (int32_t)osThreadFlagsWait(kDisplayFlagDmaDone | kDisplayFlagDmaError,
-                                             osFlagsWaitAny,
-                                             kDisplayFlushTimeoutMs);
-  if (flags < 0)
+  const uint8_t *buf = renderGetBuffer();
+  HAL_StatusTypeDef st = HAL_ERROR;
+  if (buf != NULL)
   {
-    if (LCD_FlushDMA_IsDone())
-    {
-      s_display_busy = false;
-    }
-    renderMarkDirtyList(s_rows, count);
+    st = full ? LCD_StageAll_DMA(&s_display, buf) : LCD_StageRows_DMA(&s_display, buf, rows, count);
+  }
+
+  if (!display_complete_transfer(kDisplayFlushTimeoutMs))
+  {
+    s_display_stalled = true;
+    renderMarkDirtyList(rows, count);
     return;
   }
 
-  if (LCD_FlushDMA_IsDone())
+  if (st == HAL_OK)
   {
-    s_display_busy = false;
+    (void)osThreadFlagsClear(kDisplayFlagDmaDone | kDisplayFlagDmaError);
+    st = LCD_StartStaged_DMA(&s_display);
   }
-  if ((flags & (int32_t)kDisplayFlagDmaError) != 0)
+  if (st != HAL_OK)
   {
-    renderMarkDirtyList(s_rows, count);
+    renderMarkDirtyList(rows, count);
+    return;
   }
+
+  s_row_count[slot] = count;
+  s_inflight_slot = slot;
+  s_display_busy = true;
 }
 
 static void display_init(void)
 {
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
   renderInit();
+#if RENDER_CHECK
+  render_check_run();
+#endif
+#if RENDER_BENCH
+  render_bench_run();
+#endif
 
   /* VLT_LCD is active-low and held low in main; do not change it here. */
 
@@ -125,6 +236,7 @@ void display_task_run(void)
   {
     if (power_task_is_quiescing() != 0U)
     {
+      (void)display_complete_transfer(0U);
       if (!s_display_busy)
       {
         power_task_quiesce_ack(POWER_QUIESCE_ACK_DISPLAY);
@@ -144,37 +256,21 @@ void display_task_run(void)
       continue;
     }
 
-    display_handle_cmd(cmd);
+    uint32_t start = DWT->CYCCNT;
+    bool frame = display_handle_cmd(cmd);
     while (osMessageQueueGet(qDisplayCmdHandle, &cmd, NULL, 0U) == osOK)
     {
-      display_handle_cmd(cmd);
+      frame = display_handle_cmd(cmd) || frame;
     }
+    uint32_t drawn = DWT->CYCCNT;
 
     display_flush_dirty();
 
-    if ((power_task_is_sleepface_active() == 0U) &&
-        !s_display_busy &&
-        (render_demo_get_mode() == RENDER_DEMO_MODE_RUN))
+    /* Demo frames are paced by tskGame; tell it this one is on its way. */
+    if (frame)
     {
-      uint32_t mode_flags = 0U;
-      if (egModeHandle != NULL)
-      {
-        uint32_t flags = osEventFlagsGet(egModeHandle);
-        if ((int32_t)flags >= 0)
-        {
-          mode_flags = flags;
-        }
-      }
-
-      if ((mode_flags & APP_MODE_GAME) != 0U)
-      {
-        app_display_cmd_t cmd = APP_DISPLAY_CMD_RENDER_DEMO;
-        (void)osMessageQueuePut(qDisplayCmdHandle, &cmd, 0U, 0U);
-      }
-      else
-      {
-        render_demo_set_mode(RENDER_DEMO_MODE_IDLE);
-      }
+      game_task_frame_presented(display_cycles_to_us(drawn - start),
+                                display_cycles_to_us(DWT->CYCCNT - drawn));
     }
   }
 }
@@ -0,0 +1,207 @@
+/*
+ * fixed3d.c
+ *
+ * Q16.16 fixed-point 3D helpers (see fixed3d.h):
+ *  - Table sine/cosine on binary angles
+ *  - 3x3 rotation matrices and batched vertex transform
+ *  - Perspective projection to renderer points
+ *
+ * Notes:
+ *  - Products go through a 64-bit multiply and one shift (SMULL on the M33);
+ *    projection costs one 32-bit divide per vertex.
+ */
+
+#include "fixed3d.h"
+
+#include <stddef.h>
+
+/* sin() over a quarter turn in 256 steps, Q16; the last entry closes the interval. */
+#define SINE_QUARTER_STEPS  (256U)
+#define SINE_FRAC_BITS      (6U)   /* 16384 / SINE_QUARTER_STEPS = 2^6 angle units per step */
+
+static const int32_t kSineQuarter[SINE_QUARTER_STEPS + 1U] =
+{
+  0, 402, 804, 1206, 1608, 2010, 2412, 2814,
+  3216, 3617, 4019, 4420, 4821, 5222, 5623, 6023,
+  6424, 6824, 7224, 7623, 8022, 8421, 8820, 9218,
+  9616, 10014, 10411, 10808, 11204, 11600, 11996, 12391,
+  12785, 13180, 13573, 13966, 14359, 14751, 15143, 15534,
+  15924, 16314, 16703, 17091, 17479, 17867, 18253, 18639,
+  19024, 19409, 19792, 20175, 20557, 20939, 21320, 21699,
+  22078, 22457, 22834, 23210, 23586, 23961, 24335, 24708,
+  25080, 25451, 25821, 26190, 26558, 26925, 27291, 27656,
+  28020, 28383, 28745, 29106, 29466, 29824, 30182, 30538,
+  30893, 31248, 31600, 31952, 32303, 32652, 33000, 33347,
+  33692, 34037, 34380, 34721, 35062, 35401, 35738, 36075,
+  36410, 36744, 37076, 37407, 37736, 38064, 38391, 38716,
+  39040, 39362, 39683, 40002, 40320, 40636, 40951, 41264,
+  41576, 41886, 42194, 42501, 42806, 43110, 43412, 43713,
+  44011, 44308, 44604, 44898, 45190, 45480, 45769, 46056,
+  46341, 46624, 46906, 47186, 47464, 47741, 48015, 48288,
+  48559, 48828, 49095, 49361, 49624, 49886, 50146, 50404,
+  50660, 50914, 51166, 51417, 51665, 51911, 52156, 52398,
+  52639, 52878, 53114, 53349, 53581, 53812, 54040, 54267,
+  54491, 54714, 54934, 55152, 55368, 55582, 55794, 56004,
+  56212, 56418, 56621, 56823, 57022, 57219, 57414, 57607,
+  57798, 57986, 58172, 58356, 58538, 58718, 58896, 59071,
+  59244, 59415, 59583, 59750, 59914, 60075, 60235, 60392,
+  60547, 60700, 60851, 60999, 61145, 61288, 61429, 61568,
+  61705, 61839, 61971, 62101, 62228, 62353, 62476, 62596,
+  62714, 62830, 62943, 63054, 63162, 63268, 63372, 63473,
+  63572, 63668, 63763, 63854, 63944, 64031, 64115, 64197,
+  64277, 64354, 64429, 64501, 64571, 64639, 64704, 64766,
+  64827, 64884, 64940, 64993, 65043, 65091, 65137, 65180,
+  65220, 65259, 65294, 65328, 65358, 65387, 65413, 65436,
+  65457, 65476, 65492, 65505, 65516, 65525, 65531, 65535,
+  65536
+};
+
+/* sin() of an angle within the first quarter turn, 0..16384 inclusive. */
+static q16_t sine_quarter(uint32_t a)
+{
+  const uint32_t i = a >> SINE_FRAC_BITS;
+  const int32_t frac = (int32_t)(a & ((1UL << SINE_FRAC_BITS) - 1UL));
+
+  if (i >= SINE_QUARTER_STEPS)
+  {
+    return kSineQuarter[SINE_QUARTER_STEPS];
+  }
+
+  const int32_t s0 = kSineQuarter[i];
+  return s0 + (((kSineQuarter[i + 1U] - s0) * frac) >> SINE_FRAC_BITS);
+}
+
+q16_t fx3d_sin(fx3d_angle_t a)
+{
+  const uint32_t quarter = (uint32_t)a >> 14U;
+  const uint32_t offset = (uint32_t)a & 0x3FFFU;
+
+  switch (quarter)
+  {
+    case 0U:
+      return sine_quarter(offset);
+    case 1U:
+      return sine_quarter(0x4000U - offset);
+    case 2U:
+      return -sine_quarter(offset);
+    default:
+      return -sine_quarter(0x4000U - offset);
+  }
+}
+
+q16_t fx3d_cos(fx3d_angle_t a)
+{
+  return fx3d_sin((fx3d_angle_t)(a + 0x4000U));
+}
+
+q16_t fx3d_dot(const fx3d_vec3_t *a, const fx3d_vec3_t *b)
+{
+  const int64_t acc = ((int64_t)a->x * b->x) + ((int64_t)a->y * b->y) + ((int64_t)a->z * b->z);
+  return (q16_t)(acc >> 16);
+}
+
+void fx3d_mat3_identity(fx3d_mat3_t *m)
+{
+  for (uint32_t r = 0U; r < 3U; ++r)
+  {
+    for (uint32_t c = 0U; c < 3U; ++c)
+    {
+      m->m[r][c] = (r == c) ? Q16_ONE : 0;
+    }
+  }
+}
+
+void fx3d_mat3_rot_yx(fx3d_mat3_t *m, fx3d_angle_t ay, fx3d_angle_t ax)
+{
+  const q16_t cy = fx3d_cos(ay);
+  const q16_t sy = fx3d_sin(ay);
+  const q16_t cx = fx3d_cos(ax);
+  const q16_t sx = fx3d_sin(ax);
+
+  m->m[0][0] = cy;
+  m->m[0][1] = 0;
+  m->m[0][2] = sy;
+
+  m->m[1][0] = q16_mul(sy, sx);
+  m->m[1][1] = cx;
+  m->m[1][2] = -q16_mul(cy, sx);
+
+  m->m[2][0] = -q16_mul(sy, cx);
+  m->m[2][1] = sx;
+  m->m[2][2] = q16_mul(cy, cx);
+}
+
+void fx3d_mat3_mul(const fx3d_mat3_t *a, const fx3d_mat3_t *b, fx3d_mat3_t *out)
+{
+  fx3d_mat3_t tmp;
+
+  for (uint32_t r = 0U; r < 3U; ++r)
+  {
+    for (uint32_t c = 0U; c < 3U; ++c)
+    {
+      const int64_t acc = ((int64_t)a->m[r][0] * b->m[0][c]) +
+                          ((int64_t)a->m[r][1] * b->m[1][c]) +
+                          ((int64_t)a->m[r][2] * b->m[2][c]);
+      tmp.m[r][c] = (q16_t)(acc >> 16);
+    }
+  }
+
+  *out = tmp;
+}
+
+void fx3d_transform(const fx3d_mat3_t *m, const fx3d_vec3_t *v, fx3d_vec3_t *out)
+{
+  fx3d_transform_points(m, v, out, 1U);
+}
+
+void fx3d_transform_points(const fx3d_mat3_t *m, const fx3d_vec3_t *in, fx3d_vec3_t *out, uint32_t count)
+{
+  if ((m == NULL) || (in == NULL) || (out == NULL))
+  {
+    return;
+  }
+
+  /* Keep the matrix in locals so the loop is loads, nine SMLALs and stores. */
+  const q16_t m00 = m->m[0][0], m01 = m->m[0][1], m02 = m->m[0][2];
+  const q16_t m10 = m->m[1][0], m11 = m->m[1][1], m12 = m->m[1][2];
+  const q16_t m20 = m->m[2][0], m21 = m->m[2][1], m22 = m->m[2][2];
+
+  for (uint32_t i = 0U; i < count; ++i)
+  {
+    const int64_t x = in[i].x;
+    const int64_t y = in[i].y;
+    const int64_t z = in[i].z;
+
+    out[i].x = (q16_t)(((x * m00) + (y * m01) + (z * m02)) >> 16);
+    out[i].y = (q16_t)(((x * m10) + (y * m11) + (z * m12)) >> 16);
+    out[i].z = (q16_t)(((x * m20) + (y * m21) + (z * m22)) >> 16);
+  }
+}
+
+/* n / d rounded to nearest, halves away from zero; d > 0. */
+static int32_t div_round(int32_t n, int32_t d)
+{
+  return (n >= 0) ? ((n + (d / 2)) / d) : ((n - (d / 2)) / d);
+}
+
+void fx3d_project_points(const fx3d_camera_t *cam, const fx3d_vec3_t *in, render_point_t *out, uint32_t count)
+{
+  if ((cam == NULL) || (in == NULL) || (out == NULL))
+  {
+    return;
+  }
+
+  const q16_t near_z = (cam->near_z > 0) ? cam->near_z : 1;
+
+  for (uint32_t i = 0U; i < count; ++i)
+  {
+    q16_t z = in[i].z + cam->z_offset;
+    if (z < near_z)
+    {
+      z = near_z;
+    }
+
+    out[i].x = (int16_t)(cam->cx + div_round(cam->focal * in[i].x, z));
+    out[i].y = (int16_t)(cam->cy - div_round(cam->focal * in[i].y, z));
+  }
+}
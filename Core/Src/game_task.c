@@ -6,63 +6,270 @@
 #include "sound_manager.h"
 #include "power_task.h"
 
-void game_task_run(void)
+#include <stdbool.h>
+
+static const uint32_t kGameFlagPresented = (1UL << 0U);
+/* Posted by game_task_wake(); no press bit, so game_handle_event() drops it. */
+static const app_game_event_t kGameEventWake = (1UL << 16U);
+/* Ticks this far behind are dropped rather than simulated back to back. */
+static const uint32_t kGameMaxLagMs = 250U;
+/* Simulation ticks per frame slot for Cruise/Mid/Turbo: 10, 15 and 30 FPS. */
+static const uint8_t kGameFrameTicks[] = { 3U, 2U, 1U };
+
+/* Written field by field by the task that owns the value; see the header. */
+static volatile game_frame_stats_t s_stats;
+
+/* Tick deadlines are base + n * 1000 / GAME_TICK_HZ; base moves once a second. */
+static uint32_t s_tick_base_ms = 0U;
+static uint32_t s_tick_index = 0U;
+static uint32_t s_frame_countdown = 0U;
+static uint32_t s_last_submit_ms = 0U;
+static bool s_frame_inflight = false;
+
+static uint32_t game_tick_deadline(void)
 {
-  app_game_event_t event = 0U;
+  return s_tick_base_ms + ((s_tick_index * 1000U) / GAME_TICK_HZ);
+}
 
-  for (;;)
+static void game_tick_step(void)
+{
+  s_tick_index++;
+  if (s_tick_index >= GAME_TICK_HZ)
+  {
+    s_tick_index = 0U;
+    s_tick_base_ms += 1000U;
+  }
+}
+
+static uint32_t game_frame_ticks(void)
+{
+  power_perf_mode_t mode = power_task_get_perf_mode();
+  if ((uint32_t)mode >= (sizeof(kGameFrameTicks) / sizeof(kGameFrameTicks[0])))
   {
-    if (osMessageQueueGet(qGameEventsHandle, &event, NULL, osWaitForever) != osOK)
+    mode = POWER_PERF_MODE_CRUISE;
+  }
+  return kGameFrameTicks[mode];
+}
+
+static bool game_mode_active(void)
+{
+  if (egModeHandle == NULL)
+  {
+    return false;
+  }
+  uint32_t flags = osEventFlagsGet(egModeHandle);
+  return ((int32_t)flags >= 0) && ((flags & APP_MODE_GAME) != 0U);
+}
+
+/* True while the loop should pace the demo; a demo left outside game mode stops. */
+static bool game_demo_running(void)
+{
+  if (render_demo_get_mode() != RENDER_DEMO_MODE_RUN)
+  {
+    return false;
+  }
+  if (!game_mode_active())
+  {
+    render_demo_set_mode(RENDER_DEMO_MODE_IDLE);
+    return false;
+  }
+  return (power_task_is_sleepface_active() == 0U) && (power_task_is_quiescing() == 0U);
+}
+
+static void game_loop_start(uint32_t now_ms)
+{
+  s_tick_base_ms = now_ms;
+  s_tick_index = 0U;
+  s_frame_countdown = 0U;
+  s_last_submit_ms = now_ms;
+  s_frame_inflight = false;
+  (void)osThreadFlagsClear(kGameFlagPresented);
+
+  s_stats.period_ms = 0U;
+  s_stats.frame_ms = 0U;
+  s_stats.render_us = 0U;
+  s_stats.flush_us = 0U;
+  s_stats.frames = 0U;
+  s_stats.dropped = 0U;
+  s_stats.ticks = 0U;
+}
+
+static void game_handle_event(app_game_event_t event)
+{
+  if ((event & (1UL << 8U)) == 0U)
+  {
+    return;
+  }
+
+  /* A running demo picks up the change at its next frame slot. */
+  const bool demo_running = (render_demo_get_mode() == RENDER_DEMO_MODE_RUN);
+  uint32_t button_id = (event & 0xFFU);
+  if (button_id == (uint32_t)APP_BUTTON_B)
+  {
+    sound_play(SND_MUSIC_MEGAMAN);
+    return;
+  }
+  if (button_id == (uint32_t)APP_BUTTON_L)
+  {
+    if (demo_running)
     {
-      continue;
+      render_demo_toggle_background();
     }
-
-    if ((event & (1UL << 8U)) == 0U)
+    else
     {
-      continue;
+      app_display_cmd_t cmd = APP_DISPLAY_CMD_TOGGLE;
+      (void)osMessageQueuePut(qDisplayCmdHandle, &cmd, 0U, 0U);
     }
+    return;
+  }
 
-    uint32_t button_id = (event & 0xFFU);
-    if (button_id == (uint32_t)APP_BUTTON_B)
+  if (button_id == (uint32_t)APP_BUTTON_A)
+  {
+    if (demo_running)
     {
-      sound_play(SND_MUSIC_MEGAMAN);
-      continue;
+      render_demo_toggle_cube();
     }
-    if (button_id == (uint32_t)APP_BUTTON_L)
+    return;
+  }
+
+  if (button_id == (uint32_t)APP_GAME_DEMO_BUTTON)
+  {
+    power_task_cycle_game_perf_mode();
+  }
+}
+
+/* Input is sampled once per tick so every tick sees a fixed set of events. */
+static void game_sample_input(void)
+{
+  app_game_event_t event = 0U;
+  while (osMessageQueueGet(qGameEventsHandle, &event, NULL, 0U) == osOK)
+  {
+    game_handle_event(event);
+  }
+}
+
+/*
+ * Frame slot: submit a frame unless the previous one is still being drawn
+ * or flushed. A busy display gets until the next tick to present; after
+ * that the slot is dropped, like a missed vsync.
+ */
+static void game_submit_frame(void)
+{
+  if (s_frame_inflight)
+  {
+    int32_t wait = (int32_t)(game_tick_deadline() - osKernelGetTickCount());
+    uint32_t flags = osThreadFlagsWait(kGameFlagPresented, osFlagsWaitAny,
+                                       (wait > 0) ? (uint32_t)wait : 0U);
+    if (((int32_t)flags < 0) || ((flags & kGameFlagPresented) == 0U))
     {
-      if (render_demo_get_mode() == RENDER_DEMO_MODE_RUN)
-      {
-        render_demo_toggle_background();
-        app_display_cmd_t cmd = APP_DISPLAY_CMD_RENDER_DEMO;
-        (void)osMessageQueuePut(qDisplayCmdHandle, &cmd, 0U, 0U);
-      }
-      else
-      {
-        app_display_cmd_t cmd = APP_DISPLAY_CMD_TOGGLE;
-        (void)osMessageQueuePut(qDisplayCmdHandle, &cmd, 0U, 0U);
-      }
-      continue;
+      s_stats.dropped++;
+      return;
     }
+    s_frame_inflight = false;
+  }
+
+  app_display_cmd_t cmd = APP_DISPLAY_CMD_RENDER_DEMO;
+  if (osMessageQueuePut(qDisplayCmdHandle, &cmd, 0U, 0U) != osOK)
+  {
+    s_stats.dropped++;
+    return;
+  }
+
+  uint32_t now = osKernelGetTickCount();
+  s_stats.frame_ms = now - s_last_submit_ms;
+  s_last_submit_ms = now;
+  s_frame_inflight = true;
+}
+
+static void game_run_tick(void)
+{
+  uint32_t flags = osThreadFlagsWait(kGameFlagPresented, osFlagsWaitAny, 0U);
+  if (((int32_t)flags >= 0) && ((flags & kGameFlagPresented) != 0U))
+  {
+    s_frame_inflight = false;
+  }
+
+  game_sample_input();
+  render_demo_advance(1U);
+  s_stats.ticks++;
+
+  if (s_frame_countdown == 0U)
+  {
+    s_frame_countdown = game_frame_ticks();
+    s_stats.period_ms = (s_frame_countdown * 1000U) / GAME_TICK_HZ;
+    game_submit_frame();
+  }
+  s_frame_countdown--;
+}
+
+void game_task_run(void)
+{
+  bool running = false;
 
-    if (button_id == (uint32_t)APP_BUTTON_A)
+  for (;;)
+  {
+    if (!game_demo_running())
     {
-      if (render_demo_get_mode() == RENDER_DEMO_MODE_RUN)
+      running = false;
+      /* Blocks until input or game_task_wake(): no timed wakeups outside the demo. */
+      app_game_event_t event = 0U;
+      if (osMessageQueueGet(qGameEventsHandle, &event, NULL, osWaitForever) == osOK)
       {
-        render_demo_toggle_cube();
-        app_display_cmd_t cmd = APP_DISPLAY_CMD_RENDER_DEMO;
-        (void)osMessageQueuePut(qDisplayCmdHandle, &cmd, 0U, 0U);
+        game_handle_event(event);
       }
       continue;
     }
 
-    if (button_id == (uint32_t)APP_GAME_DEMO_BUTTON)
+    uint32_t now = osKernelGetTickCount();
+    if (!running)
     {
-      power_task_cycle_game_perf_mode();
-      if (render_demo_get_mode() == RENDER_DEMO_MODE_RUN)
-      {
-        app_display_cmd_t cmd = APP_DISPLAY_CMD_RENDER_DEMO;
-        (void)osMessageQueuePut(qDisplayCmdHandle, &cmd, 0U, 0U);
-      }
+      game_loop_start(now);
+      running = true;
+    }
+    else if ((int32_t)(now - game_tick_deadline()) > (int32_t)kGameMaxLagMs)
+    {
+      /* A long stall (flash write, debugger) restarts the tick grid. */
+      s_tick_base_ms = now;
+      s_tick_index = 0U;
     }
+
+    (void)osDelayUntil(game_tick_deadline());
+    game_tick_step();
+    game_run_tick();
+  }
+}
+
+void game_task_get_frame_stats(game_frame_stats_t *out)
+{
+  if (out == NULL)
+  {
+    return;
+  }
+  out->period_ms = s_stats.period_ms;
+  out->frame_ms = s_stats.frame_ms;
+  out->render_us = s_stats.render_us;
+  out->flush_us = s_stats.flush_us;
+  out->frames = s_stats.frames;
+  out->dropped = s_stats.dropped;
+  out->ticks = s_stats.ticks;
+}
+
+void game_task_frame_presented(uint32_t render_us, uint32_t flush_us)
+{
+  s_stats.render_us = render_us;
+  s_stats.flush_us = flush_us;
+  s_stats.frames++;
+  if (tskGameHandle != NULL)
+  {
+    (void)osThreadFlagsSet(tskGameHandle, kGameFlagPresented);
+  }
+}
+
+void game_task_wake(void)
+{
+  if (qGameEventsHandle != NULL)
+  {
+    /* A full queue wakes the task just as well. */
+    (void)osMessageQueuePut(qGameEventsHandle, &kGameEventWake, 0U, 0U);
   }
 }
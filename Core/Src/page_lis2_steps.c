@@ -89,22 +89,6 @@ static void ui_draw_text_clipped(uint16_t x, uint16_t y, const char *text)
   renderDrawText(x, y, tmp, RENDER_LAYER_UI, RENDER_STATE_BLACK);
 }
 
-static uint16_t ui_text_width(const char *text)
-{
-  if (text == NULL)
-  {
-    return 0U;
-  }
-
-  size_t len = strlen(text);
-  if (len == 0U)
-  {
-    return 0U;
-  }
-
-  return (uint16_t)((len * (FONT8X8_WIDTH + 1U)) - 1U);
-}
-
 static void ui_draw_menu_line(uint16_t x, uint16_t y, const char *text, bool selected)
 {
   if (text == NULL)
@@ -114,7 +98,7 @@ static void ui_draw_menu_line(uint16_t x, uint16_t y, const char *text, bool sel
 
   if (selected)
   {
-    uint16_t text_w = ui_text_width(text);
+    uint16_t text_w = renderTextWidth(text);
     uint16_t box_w = (uint16_t)(text_w + 4U);
     if (box_w < 10U)
     {
@@ -4,24 +4,6 @@
 #include "font8x8_basic.h"
 #include "ui_router.h"
 
-#include <string.h>
-
-static uint16_t ui_text_width(const char *text)
-{
-  if (text == NULL)
-  {
-    return 0U;
-  }
-
-  size_t len = strlen(text);
-  if (len == 0U)
-  {
-    return 0U;
-  }
-
-  return (uint16_t)((len * (FONT8X8_WIDTH + 1U)) - 1U);
-}
-
 static void page_menu_render(void)
 {
   ui_router_menu_state_t state;
@@ -46,7 +28,7 @@ static void page_menu_render(void)
     bool selected = (i == state.index);
     if (selected)
     {
-      uint16_t text_w = ui_text_width(label);
+      uint16_t text_w = renderTextWidth(label);
       uint16_t box_w = (uint16_t)(text_w + 4U);
       if (box_w < 10U)
       {
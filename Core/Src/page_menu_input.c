@@ -7,7 +7,6 @@
 
 #include <stdbool.h>
 #include <stdio.h>
-#include <string.h>
 
 static uint8_t s_menu_input_index = 0U;
 static const uint8_t k_menu_input_item_count = 3U;
@@ -70,22 +69,6 @@ static uint32_t page_menu_input_event(ui_evt_t evt)
   return result;
 }
 
-static uint16_t ui_text_width(const char *text)
-{
-  if (text == NULL)
-  {
-    return 0U;
-  }
-
-  size_t len = strlen(text);
-  if (len == 0U)
-  {
-    return 0U;
-  }
-
-  return (uint16_t)((len * (FONT8X8_WIDTH + 1U)) - 1U);
-}
-
 static void page_menu_input_render(void)
 {
   sensor_joy_menu_params_t params;
@@ -121,7 +104,7 @@ static void page_menu_input_render(void)
     bool selected = (i == s_menu_input_index);
     if (selected)
     {
-      uint16_t text_w = ui_text_width(line);
+      uint16_t text_w = renderTextWidth(line);
       uint16_t box_w = (uint16_t)(text_w + 4U);
       if (box_w < 10U)
       {
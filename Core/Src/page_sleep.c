@@ -6,7 +6,6 @@
 
 #include <stdbool.h>
 #include <stdio.h>
-#include <string.h>
 
 static uint8_t s_sleep_index = 0U;
 enum { SLEEP_ITEM_COUNT = 4 };
@@ -199,22 +198,6 @@ static uint32_t page_sleep_event(ui_evt_t evt)
   return result;
 }
 
-static uint16_t ui_text_width(const char *text)
-{
-  if (text == NULL)
-  {
-    return 0U;
-  }
-
-  size_t len = strlen(text);
-  if (len == 0U)
-  {
-    return 0U;
-  }
-
-  return (uint16_t)((len * (FONT8X8_WIDTH + 1U)) - 1U);
-}
-
 static void page_sleep_render(void)
 {
   uint8_t sleep_enabled = 0U;
@@ -262,7 +245,7 @@ static void page_sleep_render(void)
     bool selected = (i == s_sleep_index);
     if (selected)
     {
-      uint16_t text_w = ui_text_width(line);
+      uint16_t text_w = renderTextWidth(line);
       uint16_t box_w = (uint16_t)(text_w + 4U);
       if (box_w < 10U)
       {
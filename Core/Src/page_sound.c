@@ -7,7 +7,6 @@
 #include "ui_router.h"
 
 #include <stdio.h>
-#include <string.h>
 
 static uint8_t s_sound_index = 0U;
 enum
@@ -25,22 +24,6 @@ static void page_sound_enter(void)
   s_sound_index = 0U;
 }
 
-static uint16_t ui_text_width(const char *text)
-{
-  if (text == NULL)
-  {
-    return 0U;
-  }
-
-  size_t len = strlen(text);
-  if (len == 0U)
-  {
-    return 0U;
-  }
-
-  return (uint16_t)((len * (FONT8X8_WIDTH + 1U)) - 1U);
-}
-
 static uint32_t page_sound_event(ui_evt_t evt)
 {
   uint32_t result = UI_PAGE_EVENT_NONE;
@@ -206,7 +189,7 @@ static void page_sound_render(void)
     bool selected = (i == s_sound_index);
     if (selected)
     {
-      uint16_t text_w = ui_text_width(line);
+      uint16_t text_w = renderTextWidth(line);
       uint16_t box_w = (uint16_t)(text_w + 4U);
       if (box_w < 10U)
       {
@@ -26,22 +26,6 @@ enum
   STORAGE_ACTION_COUNT = 5
 };
 
-static uint16_t ui_text_width(const char *text)
-{
-  if (text == NULL)
-  {
-    return 0U;
-  }
-
-  size_t len = strlen(text);
-  if (len == 0U)
-  {
-    return 0U;
-  }
-
-  return (uint16_t)((len * (FONT8X8_WIDTH + 1U)) - 1U);
-}
-
 static const char *storage_mount_label(storage_mount_state_t state)
 {
   switch (state)
@@ -521,7 +505,7 @@ static void page_storage_render_audio(void)
       bool selected = (idx == s_audio_index);
       if (selected)
       {
-        uint16_t text_w = ui_text_width(line);
+        uint16_t text_w = renderTextWidth(line);
         uint16_t box_w = (uint16_t)(text_w + 4U);
         if (box_w < 10U)
         {
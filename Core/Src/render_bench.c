@@ -0,0 +1,192 @@
+/*
+ * render_bench.c
+ *
+ * Renderer benchmark cases, shared by the on-target run
+ * (render_bench_target.c) and the host benchmark (Host/render_bench_host.c):
+ *  - One case per hot renderer entry point, each drawing one operation per
+ *    call and returning the pixels it covered
+ *
+ * Notes:
+ *  - Nothing here touches the HAL or the RTOS; the runners own the clock.
+ *  - The float vs fixed3d transform cases are host only
+ *    (Host/render_bench_host.c).
+ */
+
+#include "render_bench.h"
+
+#include "display_renderer.h"
+#include "font8x8_basic.h"
+#include "render_demo.h"
+#include "sprite.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* ----------------------------- Tunables ---------------------------------- */
+
+#define BENCH_SPRITE_W_PIXELS (64U)
+#define BENCH_SPRITE_H_PIXELS (64U)
+#define BENCH_SPRITE_STRIDE   (BENCH_SPRITE_W_PIXELS / 8U)
+#define BENCH_CIRCLE_RADIUS   (40U)
+#define BENCH_LINE_THICKNESS  (5U)
+#define BENCH_SPRITE_COUNT    (4U)
+#define BENCH_SPRITE_SIZE     (32U)
+
+/* -------------------------- Bench cases ---------------------------------- */
+
+static uint8_t s_sprite[BENCH_SPRITE_H_PIXELS * BENCH_SPRITE_STRIDE];
+static uint16_t s_rows[DISPLAY_HEIGHT];
+
+static uint32_t bench_fill(uint32_t iter, uint16_t width, uint16_t height)
+{
+  renderFill((iter & 1U) != 0U);
+  return (uint32_t)width * height;
+}
+
+static uint32_t bench_line_thick(uint32_t iter, uint16_t width, uint16_t height)
+{
+  uint16_t skew = (uint16_t)(iter % 8U);
+  uint16_t x0 = 4U;
+  uint16_t y0 = (uint16_t)(4U + skew);
+  uint16_t x1 = (uint16_t)(width - 5U);
+  uint16_t y1 = (uint16_t)(height - 5U - skew);
+  renderDrawLineThick(x0, y0, x1, y1, BENCH_LINE_THICKNESS, RENDER_LAYER_GAME,
+                      ((iter & 1U) != 0U) ? RENDER_STATE_WHITE : RENDER_STATE_BLACK);
+
+  uint32_t dx = (uint32_t)(x1 - x0);
+  uint32_t dy = (uint32_t)(y1 - y0);
+  return ((dx > dy) ? dx : dy) * BENCH_LINE_THICKNESS;
+}
+
+static uint32_t bench_fill_circle(uint32_t iter, uint16_t width, uint16_t height)
+{
+  renderFillCircle((uint16_t)(width / 2U), (uint16_t)(height / 2U), BENCH_CIRCLE_RADIUS, RENDER_LAYER_GAME,
+                   ((iter & 1U) != 0U) ? RENDER_STATE_WHITE : RENDER_STATE_BLACK);
+  return (355U * BENCH_CIRCLE_RADIUS * BENCH_CIRCLE_RADIUS) / 113U;
+}
+
+static uint32_t bench_blit_msb(uint32_t iter, uint16_t width, uint16_t height)
+{
+  /* Walk x through every byte phase. */
+  uint16_t x = (uint16_t)(((width - BENCH_SPRITE_W_PIXELS) / 2U) + (iter % 8U));
+  uint16_t y = (uint16_t)((height - BENCH_SPRITE_H_PIXELS) / 2U);
+  renderBlit1bppMsb(x, y, BENCH_SPRITE_W_PIXELS, BENCH_SPRITE_H_PIXELS, s_sprite, BENCH_SPRITE_STRIDE,
+                    RENDER_LAYER_GAME, RENDER_STATE_BLACK);
+  return BENCH_SPRITE_W_PIXELS * BENCH_SPRITE_H_PIXELS;
+}
+
+static uint32_t bench_text(uint32_t iter, uint16_t width, uint16_t height)
+{
+  static const char kText[] = "0123456789ABCDEF";
+  uint16_t y = (uint16_t)((iter * FONT8X8_HEIGHT) % (height - FONT8X8_HEIGHT));
+  (void)width;
+  renderDrawText(2U, y, kText, RENDER_LAYER_UI, RENDER_STATE_BLACK);
+  return (sizeof(kText) - 1U) * FONT8X8_WIDTH * FONT8X8_HEIGHT;
+}
+
+static uint32_t bench_pack(uint32_t iter, uint16_t width, uint16_t height)
+{
+  uint16_t count = 0U;
+  bool full = false;
+  (void)iter;
+  (void)width;
+  (void)height;
+  renderMarkDirtyRows(1U, DISPLAY_HEIGHT);
+  (void)renderTakeDirtyRows(s_rows, DISPLAY_HEIGHT, &count, &full);
+  return (uint32_t)count * DISPLAY_WIDTH;
+}
+
+/* Move a few sprites one pixel per op; only their old and new bounds are redrawn. */
+static uint32_t bench_sprites(uint32_t iter, uint16_t width, uint16_t height)
+{
+  static sprite_id_t ids[BENCH_SPRITE_COUNT];
+
+  if (iter == 0U)
+  {
+    static const sprite_image_t kImage =
+    {
+      .bitmap = s_sprite,
+      .mask = NULL,
+      .width = BENCH_SPRITE_SIZE,
+      .height = BENCH_SPRITE_SIZE,
+      .stride_bytes = BENCH_SPRITE_STRIDE
+    };
+    sprite_init();
+    for (uint32_t i = 0U; i < BENCH_SPRITE_COUNT; ++i)
+    {
+      ids[i] = sprite_create(&kImage, (int16_t)(i * (width / BENCH_SPRITE_COUNT)),
+                             (int16_t)(i * ((height - BENCH_SPRITE_SIZE) / BENCH_SPRITE_COUNT)), (int8_t)i);
+    }
+  }
+
+  for (uint32_t i = 0U; i < BENCH_SPRITE_COUNT; ++i)
+  {
+    sprite_move_by(ids[i], ((iter & 16U) != 0U) ? -1 : 1, 1 - (int16_t)((iter >> 4U) & 2U));
+  }
+  (void)sprite_render();
+  return BENCH_SPRITE_COUNT * BENCH_SPRITE_SIZE * BENCH_SPRITE_SIZE * 2U;
+}
+
+static uint32_t bench_demo_frame(uint32_t iter, uint16_t width, uint16_t height)
+{
+  /* The case starts from a cleared frame, so the demo background must be redrawn once. */
+  if (iter == 0U)
+  {
+    render_demo_reset();
+  }
+  render_demo_advance(1U);
+  render_demo_draw();
+  return (uint32_t)width * height;
+}
+
+static const render_bench_case_t kBenchCases[] =
+{
+  { "fill",       50U,  bench_fill },
+  { "line_thick", 200U, bench_line_thick },
+  { "fill_circ",  100U, bench_fill_circle },
+  { "blit_msb",   200U, bench_blit_msb },
+  { "text",       200U, bench_text },
+  { "pack",       50U,  bench_pack },
+  { "sprites",    64U,  bench_sprites },
+  { "demo_frame", 20U,  bench_demo_frame }
+};
+
+/* ----------------------------- Helpers ----------------------------------- */
+
+static void bench_prepare_sprite(void)
+{
+  for (uint32_t y = 0U; y < BENCH_SPRITE_H_PIXELS; ++y)
+  {
+    for (uint32_t b = 0U; b < BENCH_SPRITE_STRIDE; ++b)
+    {
+      s_sprite[(y * BENCH_SPRITE_STRIDE) + b] = (uint8_t)(((y & 1U) != 0U) ? 0x5AU : 0xC3U);
+    }
+  }
+}
+
+/* ------------------------------ Public ----------------------------------- */
+
+const render_bench_case_t *render_bench_cases(uint32_t *count)
+{
+  if (count != NULL)
+  {
+    *count = (uint32_t)(sizeof(kBenchCases) / sizeof(kBenchCases[0]));
+  }
+  return kBenchCases;
+}
+
+void render_bench_begin(void)
+{
+  bench_prepare_sprite();
+  renderSetFrameDiff(false);
+}
+
+void render_bench_end(void)
+{
+  /* Leave the renderer as the caller found it. */
+  sprite_init();
+  renderSetFrameDiff(true);
+  renderInit();
+  render_demo_reset();
+}
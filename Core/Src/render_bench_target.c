@@ -0,0 +1,96 @@
+/*
+ * render_bench_target.c
+ *
+ * On-target runner for the render_bench.c cases:
+ *  - Times every case with the DWT cycle counter, once per
+ *    render_rotation_t
+ *  - Logs cycles/op, ns/op and pixels/s per case, then one cycle total per
+ *    rotation to track regressions
+ *
+ * Notes:
+ *  - Runs from display_task before the first flush and resets the renderer
+ *    afterwards, so nothing it draws reaches the panel.
+ *  - The scheduler is locked around each timed batch; interrupts still run,
+ *    so results are a best case plus ISR noise.
+ */
+
+#include "render_bench.h"
+
+#include "debug_uart.h"
+#include "display_renderer.h"
+#include "main.h"
+
+#include "cmsis_os2.h"
+
+#include <stdint.h>
+
+#define BENCH_LOG_TIMEOUT_MS  (50U)
+
+static void bench_cycle_counter_enable(void)
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0U;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static void bench_log_case(render_rotation_t rotation, const char *name, uint32_t cycles, uint32_t ops,
+                           uint32_t pixels)
+{
+  uint32_t hz = SystemCoreClock;
+  uint32_t cyc_per_op = (ops != 0U) ? (cycles / ops) : 0U;
+  uint32_t ns_per_op = (hz != 0U) ? (uint32_t)(((uint64_t)cyc_per_op * 1000000000ULL) / hz) : 0U;
+  uint32_t px_per_s = (cycles != 0U) ? (uint32_t)(((uint64_t)pixels * hz) / cycles) : 0U;
+
+  debug_uart_printf("bench rot=%u %-10s %8lu cyc/op %8lu ns/op %10lu px/s\r\n",
+                    (unsigned)rotation, name,
+                    (unsigned long)cyc_per_op,
+                    (unsigned long)ns_per_op,
+                    (unsigned long)px_per_s);
+  debug_uart_wait_idle(BENCH_LOG_TIMEOUT_MS);
+}
+
+void render_bench_run(void)
+{
+  uint32_t case_count = 0U;
+  const render_bench_case_t *cases = render_bench_cases(&case_count);
+
+  bench_cycle_counter_enable();
+  render_bench_begin();
+
+  debug_uart_printf("bench start core=%lu Hz\r\n", (unsigned long)SystemCoreClock);
+  debug_uart_wait_idle(BENCH_LOG_TIMEOUT_MS);
+
+  for (uint32_t r = (uint32_t)RENDER_ROTATION_0; r <= (uint32_t)RENDER_ROTATION_270_CW; ++r)
+  {
+    render_rotation_t rotation = (render_rotation_t)r;
+    renderSetRotation(rotation);
+
+    const uint16_t width = renderGetWidth();
+    const uint16_t height = renderGetHeight();
+    uint32_t total = 0U;
+
+    for (uint32_t c = 0U; c < case_count; ++c)
+    {
+      const render_bench_case_t *bench = &cases[c];
+      uint32_t pixels = 0U;
+
+      renderFill(false);
+      int32_t lock = osKernelLock();
+      uint32_t start = DWT->CYCCNT;
+      for (uint32_t i = 0U; i < bench->iterations; ++i)
+      {
+        pixels += bench->fn(i, width, height);
+      }
+      uint32_t cycles = DWT->CYCCNT - start;
+      (void)osKernelRestoreLock(lock);
+
+      bench_log_case(rotation, bench->name, cycles, bench->iterations, pixels);
+      total += cycles / bench->iterations;
+    }
+
+    debug_uart_printf("bench rot=%u total %lu cyc\r\n", (unsigned)rotation, (unsigned long)total);
+    debug_uart_wait_idle(BENCH_LOG_TIMEOUT_MS);
+  }
+
+  render_bench_end();
+}
@@ -0,0 +1,172 @@
+/*
+ * render_check.c
+ *
+ * Golden-frame check scenarios and frame helpers, shared by the on-target
+ * runner (render_check_target.c) and the host one (Host/render_check_host.c):
+ *  - Renders each scenario from a clean renderer, packs the full frame and
+ *    takes a CRC-32 of the line data as the panel would receive it
+ *  - Converts packed rows to PBM so frames can be stored and diffed
+ *
+ * Notes:
+ *  - The golden CRCs were recorded from the host build, whose PBMs in
+ *    Host/golden/ are the reviewed images. A page drawn through libm floats
+ *    can differ by a pixel on target; dump it and compare before updating.
+ *  - Pages that show live sensor or storage state only match while those
+ *    inputs do; they are rendered without enter(), as at boot, and the host
+ *    stand-ins report a board with nothing attached.
+ *  - Demo frame i replays frames 0..i with render_demo_draw_at() on a fixed
+ *    33 ms timebase, so every frame starts from render_demo_reset() and its
+ *    render time includes the replay.
+ */
+
+#include "render_check.h"
+
+#include "display_renderer.h"
+#include "render_demo.h"
+#include "sleep_face.h"
+#include "ui_pages.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* ----------------------------- Tunables ---------------------------------- */
+
+#define CHECK_DEMO_FRAME_MS   (33U)
+
+/* -------------------------- Scenarios ------------------------------------ */
+
+static void check_sleep_face(uint32_t arg)
+{
+  static const power_rtc_datetime_t kDateTime =
+  {
+    .hours = 12U,
+    .minutes = 34U,
+    .seconds = 56U,
+    .day = 1U,
+    .month = 1U,
+    .year = 2025U
+  };
+  sleep_face_render(&kDateTime);
+}
+
+static void check_demo_frame(uint32_t frame)
+{
+  render_demo_reset();
+  for (uint32_t i = 0U; i <= frame; ++i)
+  {
+    render_demo_advance(1U);
+    render_demo_draw_at(i * CHECK_DEMO_FRAME_MS);
+  }
+}
+
+static const render_check_scenario_t kCheckScenarios[] =
+{
+  { "home",          &PAGE_HOME,          NULL,             0U, 0x3A7B4352U },
+  { "menu",          &PAGE_MENU,          NULL,             0U, 0x59B8BA7CU },
+  { "menu_input",    &PAGE_MENU_INPUT,    NULL,             0U, 0xDA8020F5U },
+  { "joy_cal",       &PAGE_JOY_CAL,       NULL,             0U, 0x5B651BA4U },
+  { "joy_target",    &PAGE_JOY_TARGET,    NULL,             0U, 0x734D2B95U },
+  { "joy_cursor",    &PAGE_JOY_CURSOR,    NULL,             0U, 0xAC147B2CU },
+  { "sound",         &PAGE_SOUND,         NULL,             0U, 0x2A8AEE3BU },
+  { "batt_stats",    &PAGE_BATT_STATS,    NULL,             0U, 0xB146C9D4U },
+  { "storage_info",  &PAGE_STORAGE_INFO,  NULL,             0U, 0x8DA62540U },
+  { "storage_audio", &PAGE_STORAGE_AUDIO, NULL,             0U, 0x407C6BA3U },
+  { "seed_audio",    &PAGE_SEED_AUDIO,    NULL,             0U, 0xADA9E8DFU },
+  { "sleep",         &PAGE_SLEEP,         NULL,             0U, 0x028DA4F3U },
+  { "rtc_set",       &PAGE_RTC_SET,       NULL,             0U, 0x02108E8EU },
+  { "lis2_imu",      &PAGE_LIS2_IMU,      NULL,             0U, 0xA2EC0846U },
+  { "lis2_steps",    &PAGE_LIS2_STEPS,    NULL,             0U, 0xE92ABF52U },
+  { "sleep_face",    NULL,                check_sleep_face, 0U, 0xEE7914F5U },
+  { "demo_0",        NULL,                check_demo_frame, 0U, 0x98A539B5U },
+  { "demo_1",        NULL,                check_demo_frame, 1U, 0xFDF76DBCU },
+  { "demo_2",        NULL,                check_demo_frame, 2U, 0xE61BFFBEU },
+  { "demo_3",        NULL,                check_demo_frame, 3U, 0xFAD0083CU },
+  { "demo_4",        NULL,                check_demo_frame, 4U, 0xC3A34F12U },
+  { "demo_5",        NULL,                check_demo_frame, 5U, 0x4280B11DU },
+  { "demo_6",        NULL,                check_demo_frame, 6U, 0x0F53A4E7U },
+  { "demo_7",        NULL,                check_demo_frame, 7U, 0xDF4DAF6CU }
+};
+
+static uint16_t s_rows[DISPLAY_HEIGHT];
+
+/* ----------------------------- Helpers ----------------------------------- */
+
+static uint32_t check_crc32(uint32_t crc, const uint8_t *data, uint32_t len)
+{
+  for (uint32_t i = 0U; i < len; ++i)
+  {
+    crc ^= data[i];
+    for (uint32_t b = 0U; b < 8U; ++b)
+    {
+      crc = (crc >> 1U) ^ (0xEDB88320UL & (0UL - (crc & 1U)));
+    }
+  }
+  return crc;
+}
+
+/* ------------------------------ Public ----------------------------------- */
+
+const render_check_scenario_t *render_check_scenarios(uint32_t *count)
+{
+  *count = (uint32_t)(sizeof(kCheckScenarios) / sizeof(kCheckScenarios[0]));
+  return kCheckScenarios;
+}
+
+void render_check_draw(const render_check_scenario_t *scenario)
+{
+  renderInit();
+  if (scenario->page != NULL)
+  {
+    if (scenario->page->render != NULL)
+    {
+      scenario->page->render();
+    }
+  }
+  else
+  {
+    scenario->fn(scenario->arg);
+  }
+}
+
+const uint8_t *render_check_pack(uint32_t *out_crc)
+{
+  uint16_t count = 0U;
+  bool full = false;
+
+  *out_crc = 0U;
+  renderMarkDirtyRows(1U, DISPLAY_HEIGHT);
+  if (!renderTakeDirtyRows(s_rows, DISPLAY_HEIGHT, &count, &full) || (count != DISPLAY_HEIGHT))
+  {
+    return NULL;
+  }
+
+  const uint8_t *frame = renderGetBuffer();
+  uint32_t crc = 0xFFFFFFFFUL;
+  for (uint16_t row = 1U; row <= DISPLAY_HEIGHT; ++row)
+  {
+    crc = check_crc32(crc, &frame[LCD_STREAM_DATA_OFFSET(row)], LINE_WIDTH);
+  }
+  *out_crc = ~crc;
+  return frame;
+}
+
+/* Panel lines are LSB-first with 1 = white; P4 rows are MSB-first with 1 = black. */
+void render_check_pbm_row(const uint8_t *frame, uint16_t row, uint8_t *out)
+{
+  const uint8_t *src = &frame[LCD_STREAM_DATA_OFFSET(row)];
+  for (uint32_t i = 0U; i < LINE_WIDTH; ++i)
+  {
+    uint8_t v = (uint8_t)~src[i];
+    v = (uint8_t)(((v & 0xF0U) >> 4U) | ((v & 0x0FU) << 4U));
+    v = (uint8_t)(((v & 0xCCU) >> 2U) | ((v & 0x33U) << 2U));
+    v = (uint8_t)(((v & 0xAAU) >> 1U) | ((v & 0x55U) << 1U));
+    out[i] = v;
+  }
+}
+
+void render_check_end(void)
+{
+  renderInit();
+  render_demo_reset();
+}
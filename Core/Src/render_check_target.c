@@ -0,0 +1,117 @@
+/*
+ * render_check_target.c
+ *
+ * On-target runner for the render_check.c scenarios:
+ *  - Times each scenario's render with the DWT cycle counter
+ *  - Compares the packed frame's CRC against the golden in the scenario
+ *    table and logs ok / FAIL / new with the render time in cycles
+ *  - Optionally dumps frames that do not match as PBM (see render_check.h)
+ *
+ * Notes:
+ *  - A golden of 0 ("new") counts as a failure: every scenario must have a
+ *    reviewed frame. Record it with Host/render_check_host --update.
+ *  - Runs from display_task before the first flush and resets the renderer
+ *    afterwards, so nothing it draws reaches the panel.
+ */
+
+#include "render_check.h"
+
+#include "debug_uart.h"
+#include "display_renderer.h"
+#include "main.h"
+
+#include <stdint.h>
+
+#define CHECK_LOG_TIMEOUT_MS  (50U)
+
+static void check_cycle_counter_enable(void)
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0U;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+#if DEBUGGING && RENDER_CHECK_DUMP
+static void check_dump_pbm(const char *name, const uint8_t *frame)
+{
+  static const char kHex[] = "0123456789abcdef";
+  uint8_t bits[LINE_WIDTH];
+  char line[(LINE_WIDTH * 2U) + 1U];
+
+  debug_uart_printf("pbm %s %u %u\r\n", name, (unsigned)DISPLAY_WIDTH, (unsigned)DISPLAY_HEIGHT);
+  debug_uart_wait_idle(CHECK_LOG_TIMEOUT_MS);
+
+  for (uint16_t row = 1U; row <= DISPLAY_HEIGHT; ++row)
+  {
+    render_check_pbm_row(frame, row, bits);
+    for (uint32_t i = 0U; i < LINE_WIDTH; ++i)
+    {
+      line[i * 2U] = kHex[bits[i] >> 4U];
+      line[(i * 2U) + 1U] = kHex[bits[i] & 0x0FU];
+    }
+    line[LINE_WIDTH * 2U] = '\0';
+    debug_uart_printf("pbm %s\r\n", line);
+    debug_uart_wait_idle(CHECK_LOG_TIMEOUT_MS);
+  }
+}
+#endif
+
+void render_check_run(void)
+{
+  uint32_t total = 0U;
+  const render_check_scenario_t *scenarios = render_check_scenarios(&total);
+  uint32_t failed = 0U;
+  uint32_t unrecorded = 0U;
+
+  check_cycle_counter_enable();
+
+  for (uint32_t i = 0U; i < total; ++i)
+  {
+    const render_check_scenario_t *sc = &scenarios[i];
+
+    uint32_t start = DWT->CYCCNT;
+    render_check_draw(sc);
+    uint32_t cycles = DWT->CYCCNT - start;
+
+    uint32_t crc = 0U;
+    const uint8_t *frame = render_check_pack(&crc);
+    const char *verdict;
+    if (frame == NULL)
+    {
+      verdict = "FAIL(pack)";
+      ++failed;
+    }
+    else if (sc->golden == 0U)
+    {
+      verdict = "new";
+      ++unrecorded;
+      ++failed;
+    }
+    else if (crc == sc->golden)
+    {
+      verdict = "ok";
+    }
+    else
+    {
+      verdict = "FAIL";
+      ++failed;
+    }
+
+    debug_uart_printf("check %-13s 0x%08lX %-10s %8lu cyc\r\n",
+                      sc->name, (unsigned long)crc, verdict, (unsigned long)cycles);
+    debug_uart_wait_idle(CHECK_LOG_TIMEOUT_MS);
+
+#if DEBUGGING && RENDER_CHECK_DUMP
+    if ((frame != NULL) && (crc != sc->golden))
+    {
+      check_dump_pbm(sc->name, frame);
+    }
+#endif
+  }
+
+  debug_uart_printf("check done %lu/%lu failed (%lu new)\r\n",
+                    (unsigned long)failed, (unsigned long)total, (unsigned long)unrecorded);
+  debug_uart_wait_idle(CHECK_LOG_TIMEOUT_MS);
+
+  render_check_end();
+}
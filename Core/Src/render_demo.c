@@ -2,40 +2,54 @@
  * render_demo.c
  *
  * Demo/test scene renderer:
- *  - Optional 1bpp tiled scrolling background
- *  - Optional blinking/thick wireframe cube
+ *  - Optional 1bpp tiled scrolling background (tilemap, redrawn incrementally)
+ *  - Optional solid cube with dither-shaded faces (fixed-point, see fixed3d.h)
  *  - Simple top/bottom UI bars with FPS + uptime
  *
  * Notes:
- *  - Background bitmap is 1bpp, stored MSB-first per byte (bit 7 = leftmost).
+ *  - Background bitmap is 1bpp, stored MSB-first per byte (bit 7 = leftmost),
+ *    and cut into tilemap tiles once per init.
+ *  - The background layer persists across frames; only the UI and game
+ *    layers are cleared per frame.
  *  - This module assumes the display_renderer API provides:
- *      renderGetWidth(), renderGetHeight(), renderFill(),
- *      renderFillRect(), renderBlit1bpp(), renderDrawText(),
- *      renderDrawLineThick()
- *  - Timebase comes from CMSIS-RTOS2 ticks (osKernelGetTickCount()).
+ *      renderGetWidth(), renderGetHeight(), renderFill(), renderClearLayer(),
+ *      renderFillRect(), renderDrawText(), renderFillPolygonDither()
+ *  - Timebase comes from CMSIS-RTOS2 ticks (osKernelGetTickCount()), or the
+ *    caller via render_demo_draw_at().
+ *  - Animation moves only by simulation ticks posted with
+ *    render_demo_advance(); a draw applies the ticks posted since the last
+ *    one, so the motion rate does not depend on the frame rate.
  */
 
 #include "render_demo.h"
 
 #include "display_renderer.h"
+#include "fixed3d.h"
 #include "font8x8_basic.h"
 #include "power_task.h"
+#include "tilemap.h"
 
 #include "cmsis_os2.h"
 
-#include <math.h>
 #include <stdbool.h>
 #include <stdint.h>
-#include <string.h>
 
 /* ----------------------------- Tunables ---------------------------------- */
 
 #define UI_BAR_H_PIXELS     (14U)  /* Height of top/bottom UI bars (if enabled) */
-#define EDGE_THICK_PIXELS   (5U)   /* Thickness for cube edges */
+#define CUBE_SHADE_LIGHT    (2U)   /* Dither level of a face lit head-on */
+#define CUBE_SHADE_DARK     (14U)  /* Dither level of a face turned from the light */
+#define CUBE_SPIN_Y_STEP    FX3D_ANGLE_RAD(0.045)  /* Y rotation per tick */
+#define CUBE_SPIN_X_STEP    FX3D_ANGLE_RAD(0.027)  /* X rotation per tick */
 
 #define BG_PATTERN_W_PIXELS (20U)  /* Pattern bitmap width (pixels) */
 #define BG_PATTERN_H_PIXELS (34U)  /* Pattern bitmap height (pixels) */
 
+/* Smallest whole-tile map that repeats the pattern: lcm(20, 8) x lcm(34, 8) pixels. */
+#define BG_MAP_W_TILES      (5U)
+#define BG_MAP_H_TILES      (17U)
+#define BG_TILE_COUNT       (BG_MAP_W_TILES * BG_MAP_H_TILES)
+
 /* -------------------------- Static assets -------------------------------- */
 
 /* 1bpp background pattern, tiled across the screen.
@@ -59,28 +73,48 @@ static const uint8_t kBgPattern1bpp[] =
   0xD5U, 0x62U, 0x30U, 0xAAU, 0xE8U, 0x80U
 };
 
-/* ------------------------- Geometry / math ------------------------------- */
+/* Background cut into tiles, and the map that lays them out in order. */
+static uint8_t s_bg_tiles[BG_TILE_COUNT * TILEMAP_TILE_PIXELS];
+static uint8_t s_bg_map[BG_TILE_COUNT];
 
-typedef struct { float   x, y, z; } vec3_t;
-typedef struct { int16_t x, y;    } pt2_t;
+/* ------------------------- Geometry / math ------------------------------- */
 
 /* Cube model vertices (centered). */
-static const vec3_t kCubeVerts[8] =
+#define CUBE_HALF_EXTENT Q16_C(0.6)
+
+static const fx3d_vec3_t kCubeVerts[8] =
 {
-  {-0.6f, -0.6f, -0.6f}, {+0.6f, -0.6f, -0.6f},
-  {+0.6f, +0.6f, -0.6f}, {-0.6f, +0.6f, -0.6f},
-  {-0.6f, -0.6f, +0.6f}, {+0.6f, -0.6f, +0.6f},
-  {+0.6f, +0.6f, +0.6f}, {-0.6f, +0.6f, +0.6f}
+  {-CUBE_HALF_EXTENT, -CUBE_HALF_EXTENT, -CUBE_HALF_EXTENT}, {+CUBE_HALF_EXTENT, -CUBE_HALF_EXTENT, -CUBE_HALF_EXTENT},
+  {+CUBE_HALF_EXTENT, +CUBE_HALF_EXTENT, -CUBE_HALF_EXTENT}, {-CUBE_HALF_EXTENT, +CUBE_HALF_EXTENT, -CUBE_HALF_EXTENT},
+  {-CUBE_HALF_EXTENT, -CUBE_HALF_EXTENT, +CUBE_HALF_EXTENT}, {+CUBE_HALF_EXTENT, -CUBE_HALF_EXTENT, +CUBE_HALF_EXTENT},
+  {+CUBE_HALF_EXTENT, +CUBE_HALF_EXTENT, +CUBE_HALF_EXTENT}, {-CUBE_HALF_EXTENT, +CUBE_HALF_EXTENT, +CUBE_HALF_EXTENT}
 };
 
-/* Cube edges as index pairs into kCubeVerts. */
-static const uint8_t kCubeEdges[12][2] =
+/* Camera-ish constants tuned to “look good” on small displays. */
+#define CUBE_Z_OFFSET    Q16_C(2.3)   /* push the model away from camera */
+#define CUBE_NEAR_Z      Q16_C(0.25)  /* clamp to avoid insane projection */
+#define CUBE_FOCAL       (84)         /* focal length in pixels */
+
+/* Cube faces: outward normal and corners (index into kCubeVerts, in order). */
+typedef struct
 {
-  {0U, 1U}, {1U, 2U}, {2U, 3U}, {3U, 0U},
-  {4U, 5U}, {5U, 6U}, {6U, 7U}, {7U, 4U},
-  {0U, 4U}, {1U, 5U}, {2U, 6U}, {3U, 7U}
+  fx3d_vec3_t normal;
+  uint8_t     v[4];
+} cube_face_t;
+
+static const cube_face_t kCubeFaces[6] =
+{
+  { {        0,         0, -Q16_ONE}, {0U, 1U, 2U, 3U} },
+  { {        0,         0, +Q16_ONE}, {4U, 5U, 6U, 7U} },
+  { {        0, -Q16_ONE,         0}, {0U, 1U, 5U, 4U} },
+  { {        0, +Q16_ONE,         0}, {3U, 2U, 6U, 7U} },
+  { {-Q16_ONE,         0,         0}, {0U, 3U, 7U, 4U} },
+  { {+Q16_ONE,         0,         0}, {1U, 2U, 6U, 5U} }
 };
 
+/* Unit vector the light travels along (from upper left, toward the scene). */
+static const fx3d_vec3_t kLightDir = { Q16_C(0.48), Q16_C(-0.56), Q16_C(0.67) };
+
 /* -------------------------- Demo state ----------------------------------- */
 
 typedef struct
@@ -93,14 +127,16 @@ typedef struct
   uint16_t ui_bar_h;
   uint16_t game_y0;      /* Inclusive */
   uint16_t game_y1;      /* Inclusive */
+  render_rotation_t rotation;
 
-  float    ay;           /* Y rotation angle (radians) */
-  float    ax;           /* X rotation angle (radians) */
+  fx3d_angle_t ay;       /* Y rotation angle */
+  fx3d_angle_t ax;       /* X rotation angle */
 
   uint32_t frame_id;
 
   uint32_t scroll_x;     /* Background scroll offset (pixels) */
   uint32_t scroll_y;
+  tilemap_t bg;
 
   uint32_t fps;
   uint32_t fps_ms_acc;
@@ -122,13 +158,11 @@ static render_demo_state_t s_demo =
 
 static render_demo_mode_t s_mode = RENDER_DEMO_MODE_IDLE;
 
-/* -------------------------- Small helpers -------------------------------- */
+/* Posted by the simulation, consumed by the draw; each has a single writer. */
+static volatile uint32_t s_ticks_posted = 0U;
+static uint32_t s_ticks_applied = 0U;
 
-static int32_t iroundf(float x)
-{
-  /* Symmetric rounding to nearest integer. */
-  return (int32_t)(x >= 0.0f ? (x + 0.5f) : (x - 0.5f));
-}
+/* -------------------------- Small helpers -------------------------------- */
 
 /* Decimal formatting helpers (no printf dependency). */
 static char *u32_to_dec(char *dst, uint32_t v)
@@ -159,24 +193,6 @@ static char *u2d(char *dst, uint32_t v)
   return dst;
 }
 
-/* Format millivolts as "X.XXV" (rounded to nearest 10mV). */
-static uint16_t text_width_px(const char *text)
-{
-  if (text == NULL)
-  {
-    return 0U;
-  }
-
-  const size_t len = strlen(text);
-  if (len == 0U)
-  {
-    return 0U;
-  }
-
-  /* FONT8X8_WIDTH pixels per glyph + 1px spacing between glyphs. */
-  return (uint16_t)((len * (FONT8X8_WIDTH + 1U)) - 1U);
-}
-
 /* Alternate cube edge color each frame for a blinking effect. */
 static render_state_t cube_blink_color(uint32_t frame_id)
 {
@@ -219,7 +235,7 @@ static void draw_ui_top(uint16_t width, uint32_t fps, power_perf_mode_t mode)
   renderDrawText(4U, 3U, fps_buf, RENDER_LAYER_UI, RENDER_STATE_WHITE);
 
   const char *mode_text = (label != NULL) ? label : "-";
-  const uint16_t w = text_width_px(mode_text);
+  const uint16_t w = renderTextWidth(mode_text);
   uint16_t x = 2U;
   if (width > (uint16_t)(w + 4U))
   {
@@ -255,7 +271,7 @@ static void draw_ui_bottom(uint16_t width, uint16_t height, uint32_t uptime_s)
   p = u2d(p, ss);
   *p = '\0';
 
-  const uint16_t w = text_width_px(buf);
+  const uint16_t w = renderTextWidth(buf);
   const uint16_t x = (width > (uint16_t)(w + 4U)) ? (uint16_t)(width - w - 4U) : 2U;
 
   renderDrawText(x, (uint16_t)(y0 + 3U), buf, RENDER_LAYER_UI, RENDER_STATE_WHITE);
@@ -263,193 +279,95 @@ static void draw_ui_bottom(uint16_t width, uint16_t height, uint32_t uptime_s)
 
 /* ------------------------ Background drawing ----------------------------- */
 
-static void draw_bg_span(uint16_t x, uint16_t y, uint16_t w, render_state_t color)
-{
-  if (w == 0U)
-  {
-    return;
-  }
-
-  renderFillRect(x, y, w, 1U, RENDER_LAYER_BG, color);
-}
-
-/* Draw a 1bpp bitmap as a tiled background, with scroll offsets (ox, oy).
- * This implementation uses run-length spans per scanline to reduce draw calls.
- */
-static void draw_bg_bitmap_tiled_scrolled(const uint8_t *bmp,
-                                          uint16_t bw, uint16_t bh,
-                                          uint32_t ox, uint32_t oy,
-                                          uint16_t screen_w,
-                                          uint16_t game_y0, uint16_t game_y1)
+/* Cut the tiled pattern into BG_MAP_W_TILES x BG_MAP_H_TILES distinct 8x8 tiles. */
+static void bg_build_tiles(void)
 {
-  if ((bmp == NULL) || (bw == 0U) || (bh == 0U) || (screen_w == 0U))
-  {
-    return;
-  }
-
-  if (game_y1 < game_y0)
-  {
-    return;
-  }
-
-  const uint16_t stride = (uint16_t)((bw + 7U) >> 3U); /* bytes per row */
-  const uint16_t oxm    = (uint16_t)(ox % bw);
-  const uint16_t oym    = (uint16_t)(oy % bh);
+  const uint16_t stride = (uint16_t)((BG_PATTERN_W_PIXELS + 7U) >> 3U);
 
-  for (uint16_t y = game_y0; y <= game_y1; ++y)
+  for (uint32_t t = 0U; t < BG_TILE_COUNT; ++t)
   {
-    const uint16_t sy = (uint16_t)((y - game_y0 + oym) % bh);
-    const uint8_t *row = bmp + ((uint32_t)sy * stride);
+    const uint32_t x0 = (t % BG_MAP_W_TILES) * TILEMAP_TILE_PIXELS;
+    const uint32_t y0 = (t / BG_MAP_W_TILES) * TILEMAP_TILE_PIXELS;
 
-    uint16_t sxi = oxm;     /* source x in bitmap space [0..bw-1] */
-    uint16_t span_x0 = 0U;
-
-    /* Determine initial color. */
-    uint8_t byte = row[sxi >> 3U];
-    uint8_t bit  = (uint8_t)(0x80U >> (sxi & 7U));
-    render_state_t cur = ((byte & bit) != 0U) ? RENDER_STATE_BLACK : RENDER_STATE_WHITE;
-
-    for (uint16_t x = 0U; x < screen_w; ++x)
+    for (uint32_t r = 0U; r < TILEMAP_TILE_PIXELS; ++r)
     {
-      byte = row[sxi >> 3U];
-      bit  = (uint8_t)(0x80U >> (sxi & 7U));
-      const render_state_t px = ((byte & bit) != 0U) ? RENDER_STATE_BLACK : RENDER_STATE_WHITE;
-
-      if (x == 0U)
-      {
-        cur = px;
-        span_x0 = 0U;
-      }
-      else if (px != cur)
-      {
-        draw_bg_span(span_x0, y, (uint16_t)(x - span_x0), cur);
-        cur = px;
-        span_x0 = x;
-      }
-
-      /* advance bitmap x with wrap */
-      sxi++;
-      if (sxi == bw)
+      const uint8_t *row = &kBgPattern1bpp[((y0 + r) % BG_PATTERN_H_PIXELS) * stride];
+      uint8_t bits = 0U;
+      for (uint32_t c = 0U; c < TILEMAP_TILE_PIXELS; ++c)
       {
-        sxi = 0U;
+        const uint32_t sx = (x0 + c) % BG_PATTERN_W_PIXELS;
+        if ((row[sx >> 3U] & (0x80U >> (sx & 7U))) != 0U)
+        {
+          bits |= (uint8_t)(0x80U >> c);
+        }
       }
+      s_bg_tiles[(t * TILEMAP_TILE_PIXELS) + r] = bits;
     }
-
-    /* Flush last span. */
-    if (span_x0 < screen_w)
-    {
-      draw_bg_span(span_x0, y, (uint16_t)(screen_w - span_x0), cur);
-    }
+    s_bg_map[t] = (uint8_t)t;
   }
 }
 
 /* -------------------------- Cube drawing --------------------------------- */
 
-/* Rotate around Y then X (simple Euler combo). */
-static void rot_yx(const vec3_t *v, float cy, float sy, float cx, float sx, vec3_t *o)
+/* Draw the visible cube faces as solid dithered polygons, clipped to the “game” region. */
+static void draw_solid_cube(fx3d_angle_t ay, fx3d_angle_t ax)
 {
-  const float xx = (v->x * cy) + (v->z * sy);
-  const float zz = (-v->x * sy) + (v->z * cy);
+  fx3d_mat3_t rot;
+  fx3d_vec3_t rotated[8];
+  render_point_t proj[8];
 
-  o->x = xx;
-  o->y = (v->y * cx) - (zz * sx);
-  o->z = (v->y * sx) + (zz * cx);
-}
+  fx3d_mat3_rot_yx(&rot, ay, ax);
+  fx3d_transform_points(&rot, kCubeVerts, rotated, 8U);
 
-/* Perspective project 3D points to screen coordinates. */
-static void project_points(const vec3_t *vin, pt2_t *out, uint8_t n,
-                           uint16_t width, uint16_t game_y0, uint16_t game_y1)
-{
-  /* Camera-ish constants tuned to “look good” on small displays. */
-  const float z_off  = 2.3f;   /* push the model away from camera */
-  const float near_z = 0.25f;  /* clamp to avoid insane projection */
-  const float f      = 84.0f;  /* focal length in pixels */
-
-  const float cx = (float)(width / 2U);
-  const float cy = (float)((game_y0 + game_y1) / 2U);
-
-  for (uint8_t i = 0U; i < n; ++i)
+  const fx3d_camera_t cam =
   {
-    float z = vin[i].z + z_off;
-    if (z < near_z)
-    {
-      z = near_z;
-    }
-
-    const float px = cx + (f * vin[i].x) / z;
-    const float py = cy - (f * vin[i].y) / z;
-
-    out[i].x = (int16_t)iroundf(px);
-    out[i].y = (int16_t)iroundf(py);
-  }
-}
-
-/* Draw cube edges as thick lines, clipped to the “game” region. */
-static void draw_wire_cube(float ay, float ax, render_state_t edge_color)
-{
-  vec3_t rotated[8];
-  pt2_t  proj[8];
-
-  const float cy = cosf(ay);
-  const float sy = sinf(ay);
-  const float cx = cosf(ax);
-  const float sx = sinf(ax);
-
-  for (uint8_t i = 0U; i < 8U; ++i)
+    .z_offset = CUBE_Z_OFFSET,
+    .near_z   = CUBE_NEAR_Z,
+    .focal    = CUBE_FOCAL,
+    .cx       = (int16_t)(s_demo.width / 2U),
+    .cy       = (int16_t)((s_demo.game_y0 + s_demo.game_y1) / 2U)
+  };
+  fx3d_project_points(&cam, rotated, proj, 8U);
+
+  const render_rect_t game =
   {
-    rot_yx(&kCubeVerts[i], cy, sy, cx, sx, &rotated[i]);
-  }
-
-  project_points(rotated, proj, 8U, s_demo.width, s_demo.game_y0, s_demo.game_y1);
-
-  const int32_t w  = (int32_t)s_demo.width;
-  const int32_t y0 = (int32_t)s_demo.game_y0;
-  const int32_t y1 = (int32_t)s_demo.game_y1;
-
-  const int32_t x_min = 0;
-  const int32_t x_max = (w > 0) ? (w - 1) : 0;
-
-  uint16_t thick = EDGE_THICK_PIXELS;
-  if (thick > 8U)
-  {
-    thick = 8U; /* safety cap */
-  }
+    .x = 0,
+    .y = (int16_t)s_demo.game_y0,
+    .width = s_demo.width,
+    .height = (uint16_t)(s_demo.game_y1 - s_demo.game_y0 + 1U)
+  };
 
-  for (uint8_t e = 0U; e < 12U; ++e)
+  for (uint8_t f = 0U; f < 6U; ++f)
   {
-    int32_t x0 = (int32_t)proj[kCubeEdges[e][0U]].x;
-    int32_t y0p = (int32_t)proj[kCubeEdges[e][0U]].y;
-    int32_t x1 = (int32_t)proj[kCubeEdges[e][1U]].x;
-    int32_t y1p = (int32_t)proj[kCubeEdges[e][1U]].y;
-
-    /* Trivial reject if the whole segment is off-screen horizontally. */
-    if ((x0 < 0 && x1 < 0) || (x0 >= w && x1 >= w))
+    fx3d_vec3_t n;
+    fx3d_transform(&rot, &kCubeFaces[f].normal, &n);
+
+    /*
+     * The camera sits at z = -CUBE_Z_OFFSET looking down +z, and a face
+     * center is its normal times CUBE_HALF_EXTENT, so a face is visible
+     * when the normal points back at the camera from there.
+     */
+    if ((CUBE_HALF_EXTENT + q16_mul(n.z, CUBE_Z_OFFSET)) >= 0)
     {
       continue;
     }
 
-    /* Trivial reject if the whole segment is outside vertical game window. */
-    if ((y0p < y0 && y1p < y0) || (y0p > y1 && y1p > y1))
+    /* Lambert term against a fixed light; darker faces get more black. */
+    q16_t lambert = -fx3d_dot(&n, &kLightDir);
+    if (lambert < 0)
     {
-      continue;
+      lambert = 0;
     }
+    const uint8_t level =
+      (uint8_t)(CUBE_SHADE_DARK - q16_round(lambert * (int32_t)(CUBE_SHADE_DARK - CUBE_SHADE_LIGHT)));
 
-    /* Clamp endpoints into drawable region (simple clamp, not true line clipping). */
-    if (x0 < x_min) x0 = x_min;
-    else if (x0 > x_max) x0 = x_max;
-
-    if (x1 < x_min) x1 = x_min;
-    else if (x1 > x_max) x1 = x_max;
-
-    if (y0p < y0) y0p = y0;
-    else if (y0p > y1) y0p = y1;
-
-    if (y1p < y0) y1p = y0;
-    else if (y1p > y1) y1p = y1;
+    render_point_t quad[4];
+    for (uint8_t k = 0U; k < 4U; ++k)
+    {
+      quad[k] = proj[kCubeFaces[f].v[k]];
+    }
 
-    renderDrawLineThick((uint16_t)x0, (uint16_t)y0p,
-                        (uint16_t)x1, (uint16_t)y1p,
-                        thick, RENDER_LAYER_GAME, edge_color);
+    renderFillPolygonDither(quad, 4U, &game, RENDER_LAYER_GAME, level);
   }
 }
 
@@ -459,6 +377,7 @@ static void render_demo_init(uint16_t width, uint16_t height, uint32_t now_ms)
 {
   s_demo.width  = width;
   s_demo.height = height;
+  s_demo.rotation = renderGetRotation();
 
   /* Enable UI bars only if there is enough vertical space. */
   s_demo.ui_bar_h = (height > (UI_BAR_H_PIXELS * 2U + 1U)) ? UI_BAR_H_PIXELS : 0U;
@@ -482,13 +401,14 @@ static void render_demo_init(uint16_t width, uint16_t height, uint32_t now_ms)
     s_demo.game_y1 = (height > 0U) ? (uint16_t)(height - 1U) : 0U;
   }
 
-  s_demo.ay = 0.0f;
-  s_demo.ax = 0.0f;
+  s_demo.ay = 0U;
+  s_demo.ax = 0U;
 
   s_demo.frame_id = 0U;
 
   s_demo.scroll_x = 0U;
   s_demo.scroll_y = 0U;
+  s_ticks_applied = s_ticks_posted;
 
   s_demo.fps        = 0U;
   s_demo.fps_ms_acc = 0U;
@@ -497,6 +417,20 @@ static void render_demo_init(uint16_t width, uint16_t height, uint32_t now_ms)
   s_demo.boot_ms       = now_ms;
   s_demo.last_frame_ms = now_ms;
 
+  const render_rect_t game =
+  {
+    .x = 0,
+    .y = (int16_t)s_demo.game_y0,
+    .width = width,
+    .height = (uint16_t)(s_demo.game_y1 - s_demo.game_y0 + 1U)
+  };
+  bg_build_tiles();
+  tilemap_init(&s_demo.bg, s_bg_tiles, BG_TILE_COUNT, s_bg_map, BG_MAP_W_TILES, BG_MAP_H_TILES,
+               RENDER_LAYER_BG, &game);
+
+  /* Start from a clean frame; later frames keep the background layer. */
+  renderFill(false);
+
   s_demo.initialized = true;
 }
 
@@ -538,7 +472,17 @@ void render_demo_toggle_cube(void)
   s_demo.cube_enabled = !s_demo.cube_enabled;
 }
 
+void render_demo_advance(uint32_t ticks)
+{
+  s_ticks_posted += ticks;
+}
+
 void render_demo_draw(void)
+{
+  render_demo_draw_at(osKernelGetTickCount());
+}
+
+void render_demo_draw_at(uint32_t now_ms)
 {
   const uint16_t width  = renderGetWidth();
   const uint16_t height = renderGetHeight();
@@ -548,13 +492,29 @@ void render_demo_draw(void)
     return;
   }
 
-  const uint32_t now_ms = osKernelGetTickCount();
-
-  if ((!s_demo.initialized) || (s_demo.width != width) || (s_demo.height != height))
+  if ((!s_demo.initialized) || (s_demo.width != width) || (s_demo.height != height) ||
+      (s_demo.rotation != renderGetRotation()))
   {
     render_demo_init(width, height, now_ms);
   }
 
+  /* Catch up with the simulation; disabled elements hold still. */
+  const uint32_t posted = s_ticks_posted;
+  for (uint32_t n = posted - s_ticks_applied; n > 0U; --n)
+  {
+    if (s_demo.bg_enabled)
+    {
+      s_demo.scroll_x += 1U;
+      s_demo.scroll_y += 1U;
+    }
+    if (s_demo.cube_enabled)
+    {
+      s_demo.ay = (fx3d_angle_t)(s_demo.ay + CUBE_SPIN_Y_STEP);
+      s_demo.ax = (fx3d_angle_t)(s_demo.ax + CUBE_SPIN_X_STEP);
+    }
+  }
+  s_ticks_applied = posted;
+
   /* FPS estimation using elapsed tick accumulation. */
   const uint32_t dt_ms = now_ms - s_demo.last_frame_ms;
   s_demo.last_frame_ms = now_ms;
@@ -569,32 +529,26 @@ void render_demo_draw(void)
     s_demo.fps_frames = 0U;
   }
 
-  /* Clear render buffers (module-specific: false likely means "full clear"). */
-  renderFill(false);
+  /* Clear the per-frame layers; the background is scrolled in place. */
+  renderClearLayer(RENDER_LAYER_UI);
+  renderClearLayer(RENDER_LAYER_GAME);
 
   /* Background: tiled bitmap, scrolled over time. */
   if (s_demo.bg_enabled)
   {
-    draw_bg_bitmap_tiled_scrolled(kBgPattern1bpp,
-                                  BG_PATTERN_W_PIXELS,
-                                  BG_PATTERN_H_PIXELS,
-                                  s_demo.scroll_x,
-                                  s_demo.scroll_y,
-                                  width,
-                                  s_demo.game_y0,
-                                  s_demo.game_y1);
-
-    s_demo.scroll_x += 1U;
-    s_demo.scroll_y += 1U;
+    tilemap_set_scroll(&s_demo.bg, (int32_t)s_demo.scroll_x, (int32_t)s_demo.scroll_y);
+    tilemap_draw(&s_demo.bg);
+  }
+  else
+  {
+    renderClearLayer(RENDER_LAYER_BG);
+    tilemap_invalidate(&s_demo.bg);
   }
 
-  /* Foreground: animated wireframe cube. */
+  /* Foreground: animated solid cube. */
   if (s_demo.cube_enabled)
   {
-    s_demo.ay += 0.045f;
-    s_demo.ax += 0.027f;
-
-    draw_wire_cube(s_demo.ay, s_demo.ax, RENDER_STATE_BLACK);
+    draw_solid_cube(s_demo.ay, s_demo.ax);
   }
 
   /* UI overlays (show FPS + perf mode in top bar). */
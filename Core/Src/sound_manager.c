@@ -1,6 +1,7 @@
 #include "sound_manager.h"
 
 #include "app_freertos.h"
+#include "audio_task.h"
 #include "cmsis_os2.h"
 
 #include <string.h>
@@ -22,7 +23,7 @@ static const sound_registry_entry_t s_registry[] =
     .embedded = NULL,
     .embedded_len = 0U,
     .default_gain_q8 = 255U,
-    .flags = SOUND_F_OVERLAP,
+    .flags = (sound_flags_t)(SOUND_F_OVERLAP | SOUND_F_PCM_CACHE),
     .default_prio = SOUND_PRIO_UI,
     .category = SOUND_CAT_UI,
     .cache = s_cache_ui_move,
@@ -37,7 +38,7 @@ static const sound_registry_entry_t s_registry[] =
     .embedded = NULL,
     .embedded_len = 0U,
     .default_gain_q8 = 255U,
-    .flags = SOUND_F_OVERLAP,
+    .flags = (sound_flags_t)(SOUND_F_OVERLAP | SOUND_F_PCM_CACHE),
     .default_prio = SOUND_PRIO_UI,
     .category = SOUND_CAT_UI,
     .cache = s_cache_ui_confirm,
@@ -52,7 +53,7 @@ static const sound_registry_entry_t s_registry[] =
     .embedded = NULL,
     .embedded_len = 0U,
     .default_gain_q8 = 255U,
-    .flags = SOUND_F_OVERLAP,
+    .flags = (sound_flags_t)(SOUND_F_OVERLAP | SOUND_F_PCM_CACHE),
     .default_prio = SOUND_PRIO_UI,
     .category = SOUND_CAT_UI,
     .cache = s_cache_ui_decline,
@@ -67,7 +68,7 @@ static const sound_registry_entry_t s_registry[] =
     .embedded = NULL,
     .embedded_len = 0U,
     .default_gain_q8 = 255U,
-    .flags = SOUND_F_OVERLAP,
+    .flags = (sound_flags_t)(SOUND_F_OVERLAP | SOUND_F_PCM_CACHE),
     .default_prio = SOUND_PRIO_UI,
     .category = SOUND_CAT_UI,
     .cache = s_cache_ui_denied,
@@ -182,7 +183,24 @@ void sound_play_ex(sound_id_t id, sound_prio_t prio, sound_flags_t flags)
     return;
   }
 
-  app_audio_cmd_t cmd = (app_audio_cmd_t)SOUND_CMD_MAKE_PLAY(id, prio, flags);
+  /*
+   * Stamped before the put: tskAudio runs at a higher priority and may take
+   * the command inside it. If the put fails, no command carries the tag.
+   */
+  uint8_t lat_tag = audio_latency_mark_enqueue();
+  app_audio_cmd_t cmd = (app_audio_cmd_t)(SOUND_CMD_MAKE_PLAY(id, prio, flags) |
+                                          ((uint32_t)lat_tag << SOUND_CMD_LAT_SHIFT));
+  (void)osMessageQueuePut(qAudioCmdHandle, &cmd, 0U, 0U);
+}
+
+void sound_preload(sound_id_t id)
+{
+  if (qAudioCmdHandle == NULL)
+  {
+    return;
+  }
+
+  app_audio_cmd_t cmd = (app_audio_cmd_t)SOUND_CMD_MAKE_PRELOAD(id);
   (void)osMessageQueuePut(qAudioCmdHandle, &cmd, 0U, 0U);
 }
 
@@ -0,0 +1,491 @@
+/*
+ * sprite.c
+ *
+ * Retained sprite table on the game layer (see sprite.h):
+ *  - Setters record damage: the bounds a sprite was last drawn at are
+ *    queued the first time it changes, its new bounds at sprite_render()
+ *  - Damage rectangles are clipped to the screen and merged, cleared on the
+ *    game layer and redrawn with every visible sprite that overlaps them,
+ *    clipped to the rectangle, in z order
+ *
+ * Notes:
+ *  - Unflipped sprites are blitted straight from their image through the
+ *    renderer's source window; flipped ones go through a small scratch
+ *    buffer a few rows at a time.
+ */
+
+#include "sprite.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/* ----------------------------- Tunables ---------------------------------- */
+
+#define SPRITE_SCRATCH_BYTES (256U)  /* Flipped rows staged per blit */
+#define SPRITE_DAMAGE_MAX    (SPRITE_MAX_COUNT * 2U)
+
+/* ------------------------------ State ------------------------------------ */
+
+/* Inclusive logical box; empty when x0 > x1 or y0 > y1. */
+typedef struct
+{
+  int32_t x0;
+  int32_t y0;
+  int32_t x1;
+  int32_t y1;
+} sprite_box_t;
+
+typedef struct
+{
+  sprite_image_t image;
+  int16_t        x;
+  int16_t        y;
+  int8_t         z;
+  uint8_t        flip;
+  bool           used;
+  bool           visible;
+  bool           dirty;      /* Changed since the last sprite_render() */
+  bool           drawn;      /* `drawn_box` is on the game layer */
+  uint32_t       seq;        /* Creation order, breaks z ties */
+  sprite_box_t   drawn_box;
+} sprite_slot_t;
+
+static sprite_slot_t s_sprites[SPRITE_MAX_COUNT];
+static uint8_t s_order[SPRITE_MAX_COUNT];
+static uint8_t s_order_count = 0U;
+static bool s_order_stale = false;
+static uint32_t s_next_seq = 0U;
+
+static sprite_box_t s_damage[SPRITE_DAMAGE_MAX];
+static uint16_t s_damage_count = 0U;
+static bool s_damage_all = false;
+
+static uint8_t s_scratch[SPRITE_SCRATCH_BYTES];
+
+/* ----------------------------- Helpers ----------------------------------- */
+
+static bool box_empty(const sprite_box_t *b)
+{
+  return (b->x0 > b->x1) || (b->y0 > b->y1);
+}
+
+static sprite_box_t box_intersect(const sprite_box_t *a, const sprite_box_t *b)
+{
+  sprite_box_t r;
+  r.x0 = (a->x0 > b->x0) ? a->x0 : b->x0;
+  r.y0 = (a->y0 > b->y0) ? a->y0 : b->y0;
+  r.x1 = (a->x1 < b->x1) ? a->x1 : b->x1;
+  r.y1 = (a->y1 < b->y1) ? a->y1 : b->y1;
+  return r;
+}
+
+static bool box_overlaps(const sprite_box_t *a, const sprite_box_t *b)
+{
+  sprite_box_t r = box_intersect(a, b);
+  return !box_empty(&r);
+}
+
+static void box_union(sprite_box_t *a, const sprite_box_t *b)
+{
+  a->x0 = (a->x0 < b->x0) ? a->x0 : b->x0;
+  a->y0 = (a->y0 < b->y0) ? a->y0 : b->y0;
+  a->x1 = (a->x1 > b->x1) ? a->x1 : b->x1;
+  a->y1 = (a->y1 > b->y1) ? a->y1 : b->y1;
+}
+
+static sprite_box_t slot_box(const sprite_slot_t *s)
+{
+  sprite_box_t b;
+  b.x0 = s->x;
+  b.y0 = s->y;
+  b.x1 = (int32_t)s->x + (int32_t)s->image.width - 1;
+  b.y1 = (int32_t)s->y + (int32_t)s->image.height - 1;
+  return b;
+}
+
+static bool slot_drawable(const sprite_slot_t *s)
+{
+  return s->used && s->visible && (s->image.bitmap != NULL) && (s->image.width != 0U) &&
+         (s->image.height != 0U);
+}
+
+static sprite_slot_t *slot_get(sprite_id_t id)
+{
+  if ((id >= SPRITE_MAX_COUNT) || !s_sprites[id].used)
+  {
+    return NULL;
+  }
+  return &s_sprites[id];
+}
+
+static void damage_add(const sprite_box_t *b)
+{
+  if (box_empty(b) || s_damage_all)
+  {
+    return;
+  }
+  if (s_damage_count >= SPRITE_DAMAGE_MAX)
+  {
+    s_damage_all = true;
+    return;
+  }
+  s_damage[s_damage_count++] = *b;
+}
+
+/* Queue the box a sprite was last drawn at, once per change cycle. */
+static void slot_touch(sprite_slot_t *s)
+{
+  if (s->dirty)
+  {
+    return;
+  }
+  s->dirty = true;
+  if (s->drawn)
+  {
+    damage_add(&s->drawn_box);
+  }
+}
+
+/* Stable insertion sort of the live sprites by (z, seq). */
+static void order_rebuild(void)
+{
+  s_order_count = 0U;
+  for (uint8_t i = 0U; i < SPRITE_MAX_COUNT; ++i)
+  {
+    if (!s_sprites[i].used)
+    {
+      continue;
+    }
+
+    uint8_t pos = s_order_count++;
+    while (pos > 0U)
+    {
+      const sprite_slot_t *prev = &s_sprites[s_order[pos - 1U]];
+      if ((prev->z < s_sprites[i].z) || ((prev->z == s_sprites[i].z) && (prev->seq < s_sprites[i].seq)))
+      {
+        break;
+      }
+      s_order[pos] = s_order[pos - 1U];
+      --pos;
+    }
+    s_order[pos] = i;
+  }
+  s_order_stale = false;
+}
+
+/* Draw one plane of a flipped sprite over `clip`, staging rows in s_scratch. */
+static void draw_plane_flipped(const sprite_slot_t *s, const uint8_t *plane, const sprite_box_t *clip,
+                               render_state_t state)
+{
+  const sprite_image_t *img = &s->image;
+  const uint32_t w = (uint32_t)(clip->x1 - clip->x0 + 1);
+  const uint32_t h = (uint32_t)(clip->y1 - clip->y0 + 1);
+  const uint32_t ox = (uint32_t)(clip->x0 - s->x);
+  const uint32_t oy = (uint32_t)(clip->y0 - s->y);
+  const uint16_t stride = (uint16_t)((w + 7U) / 8U);
+  const uint32_t batch_rows = SPRITE_SCRATCH_BYTES / stride;
+  if (batch_rows == 0U)
+  {
+    return;
+  }
+
+  for (uint32_t r0 = 0U; r0 < h; r0 += batch_rows)
+  {
+    const uint32_t rows = ((h - r0) < batch_rows) ? (h - r0) : batch_rows;
+    memset(s_scratch, 0, (size_t)rows * stride);
+
+    for (uint32_t r = 0U; r < rows; ++r)
+    {
+      const uint32_t dy = oy + r0 + r;
+      const uint32_t sy = ((s->flip & SPRITE_FLIP_Y) != 0U) ? (img->height - 1U - dy) : dy;
+      const uint8_t *src = &plane[sy * img->stride_bytes];
+      uint8_t *dst = &s_scratch[r * stride];
+
+      for (uint32_t c = 0U; c < w; ++c)
+      {
+        const uint32_t dx = ox + c;
+        const uint32_t sx = ((s->flip & SPRITE_FLIP_X) != 0U) ? (img->width - 1U - dx) : dx;
+        if ((src[sx >> 3U] & (0x80U >> (sx & 7U))) != 0U)
+        {
+          dst[c >> 3U] |= (uint8_t)(0x80U >> (c & 7U));
+        }
+      }
+    }
+
+    renderBlit1bppMsbEx((int16_t)clip->x0, (int16_t)(clip->y0 + (int32_t)r0), (uint16_t)w, (uint16_t)rows,
+                        s_scratch, stride, 0U, RENDER_LAYER_GAME, state, RENDER_BLIT_TRANSPARENT);
+  }
+}
+
+static void draw_plane(const sprite_slot_t *s, const uint8_t *plane, const sprite_box_t *clip,
+                       render_state_t state)
+{
+  if (s->flip != (uint8_t)SPRITE_FLIP_NONE)
+  {
+    draw_plane_flipped(s, plane, clip, state);
+    return;
+  }
+
+  const uint32_t ox = (uint32_t)(clip->x0 - s->x);
+  const uint32_t oy = (uint32_t)(clip->y0 - s->y);
+  renderBlit1bppMsbEx((int16_t)clip->x0, (int16_t)clip->y0, (uint16_t)(clip->x1 - clip->x0 + 1),
+                      (uint16_t)(clip->y1 - clip->y0 + 1), &plane[oy * s->image.stride_bytes],
+                      s->image.stride_bytes, (uint16_t)ox, RENDER_LAYER_GAME, state, RENDER_BLIT_TRANSPARENT);
+}
+
+static void draw_sprite_clipped(const sprite_slot_t *s, const sprite_box_t *clip)
+{
+  if (s->image.mask != NULL)
+  {
+    draw_plane(s, s->image.mask, clip, RENDER_STATE_WHITE);
+  }
+  draw_plane(s, s->image.bitmap, clip, RENDER_STATE_BLACK);
+}
+
+/* Merge overlapping damage boxes until none overlap. */
+static void damage_merge(void)
+{
+  bool merged = true;
+  while (merged)
+  {
+    merged = false;
+    for (uint16_t i = 0U; i < s_damage_count; ++i)
+    {
+      for (uint16_t j = (uint16_t)(i + 1U); j < s_damage_count; ++j)
+      {
+        if (box_overlaps(&s_damage[i], &s_damage[j]))
+        {
+          box_union(&s_damage[i], &s_damage[j]);
+          s_damage[j] = s_damage[--s_damage_count];
+          merged = true;
+          --j;
+        }
+      }
+    }
+  }
+}
+
+/* ------------------------------ Public ----------------------------------- */
+
+void sprite_init(void)
+{
+  memset(s_sprites, 0, sizeof(s_sprites));
+  s_order_count = 0U;
+  s_order_stale = false;
+  s_next_seq = 0U;
+  s_damage_count = 0U;
+  s_damage_all = false;
+}
+
+sprite_id_t sprite_create(const sprite_image_t *image, int16_t x, int16_t y, int8_t z)
+{
+  for (uint8_t i = 0U; i < SPRITE_MAX_COUNT; ++i)
+  {
+    sprite_slot_t *s = &s_sprites[i];
+    if (s->used)
+    {
+      continue;
+    }
+
+    memset(s, 0, sizeof(*s));
+    if (image != NULL)
+    {
+      s->image = *image;
+    }
+    s->x = x;
+    s->y = y;
+    s->z = z;
+    s->used = true;
+    s->visible = true;
+    s->dirty = true;
+    s->seq = s_next_seq++;
+    s_order_stale = true;
+    return i;
+  }
+  return SPRITE_ID_INVALID;
+}
+
+void sprite_destroy(sprite_id_t id)
+{
+  sprite_slot_t *s = slot_get(id);
+  if (s == NULL)
+  {
+    return;
+  }
+
+  slot_touch(s);
+  s->used = false;
+  s->drawn = false;
+  s_order_stale = true;
+}
+
+void sprite_set_position(sprite_id_t id, int16_t x, int16_t y)
+{
+  sprite_slot_t *s = slot_get(id);
+  if ((s == NULL) || ((s->x == x) && (s->y == y)))
+  {
+    return;
+  }
+
+  slot_touch(s);
+  s->x = x;
+  s->y = y;
+}
+
+void sprite_move_by(sprite_id_t id, int16_t dx, int16_t dy)
+{
+  const sprite_slot_t *s = slot_get(id);
+  if (s != NULL)
+  {
+    sprite_set_position(id, (int16_t)(s->x + dx), (int16_t)(s->y + dy));
+  }
+}
+
+void sprite_set_image(sprite_id_t id, const sprite_image_t *image)
+{
+  sprite_slot_t *s = slot_get(id);
+  if (s == NULL)
+  {
+    return;
+  }
+
+  slot_touch(s);
+  if (image != NULL)
+  {
+    s->image = *image;
+  }
+  else
+  {
+    memset(&s->image, 0, sizeof(s->image));
+  }
+}
+
+void sprite_set_flip(sprite_id_t id, sprite_flip_t flip)
+{
+  sprite_slot_t *s = slot_get(id);
+  if ((s == NULL) || (s->flip == (uint8_t)flip))
+  {
+    return;
+  }
+
+  slot_touch(s);
+  s->flip = (uint8_t)((uint32_t)flip & (uint32_t)SPRITE_FLIP_XY);
+}
+
+void sprite_set_z(sprite_id_t id, int8_t z)
+{
+  sprite_slot_t *s = slot_get(id);
+  if ((s == NULL) || (s->z == z))
+  {
+    return;
+  }
+
+  slot_touch(s);
+  s->z = z;
+  s_order_stale = true;
+}
+
+void sprite_set_visible(sprite_id_t id, bool visible)
+{
+  sprite_slot_t *s = slot_get(id);
+  if ((s == NULL) || (s->visible == visible))
+  {
+    return;
+  }
+
+  slot_touch(s);
+  s->visible = visible;
+}
+
+bool sprite_get_bounds(sprite_id_t id, render_rect_t *out)
+{
+  const sprite_slot_t *s = slot_get(id);
+  if ((s == NULL) || (out == NULL))
+  {
+    return false;
+  }
+
+  out->x = s->x;
+  out->y = s->y;
+  out->width = s->image.width;
+  out->height = s->image.height;
+  return true;
+}
+
+void sprite_invalidate_all(void)
+{
+  s_damage_all = true;
+}
+
+uint16_t sprite_render(void)
+{
+  const sprite_box_t screen = { 0, 0, (int32_t)renderGetWidth() - 1, (int32_t)renderGetHeight() - 1 };
+
+  for (uint8_t i = 0U; i < SPRITE_MAX_COUNT; ++i)
+  {
+    sprite_slot_t *s = &s_sprites[i];
+    if (!s->used || !s->dirty)
+    {
+      continue;
+    }
+
+    s->dirty = false;
+    s->drawn = slot_drawable(s);
+    if (s->drawn)
+    {
+      s->drawn_box = slot_box(s);
+      damage_add(&s->drawn_box);
+    }
+  }
+
+  if (s_damage_all)
+  {
+    s_damage[0] = screen;
+    s_damage_count = 1U;
+    s_damage_all = false;
+  }
+
+  /* Clip to the screen, dropping what falls off it. */
+  uint16_t kept = 0U;
+  for (uint16_t i = 0U; i < s_damage_count; ++i)
+  {
+    sprite_box_t b = box_intersect(&s_damage[i], &screen);
+    if (!box_empty(&b))
+    {
+      s_damage[kept++] = b;
+    }
+  }
+  s_damage_count = kept;
+  damage_merge();
+
+  if (s_order_stale)
+  {
+    order_rebuild();
+  }
+
+  for (uint16_t d = 0U; d < s_damage_count; ++d)
+  {
+    const sprite_box_t *b = &s_damage[d];
+    renderFillRect((uint16_t)b->x0, (uint16_t)b->y0, (uint16_t)(b->x1 - b->x0 + 1), (uint16_t)(b->y1 - b->y0 + 1),
+                   RENDER_LAYER_GAME, RENDER_STATE_TRANSPARENT);
+
+    for (uint8_t k = 0U; k < s_order_count; ++k)
+    {
+      const sprite_slot_t *s = &s_sprites[s_order[k]];
+      if (!s->drawn)
+      {
+        continue;
+      }
+
+      sprite_box_t clip = box_intersect(&s->drawn_box, b);
+      if (!box_empty(&clip))
+      {
+        draw_sprite_clipped(s, &clip);
+      }
+    }
+  }
+
+  uint16_t count = s_damage_count;
+  s_damage_count = 0U;
+  return count;
+}
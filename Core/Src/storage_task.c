@@ -625,6 +625,10 @@ static void storage_cache_audio_assets(void)
     }
 
     sound_cache_set(entry->id, (uint32_t)read_len, 1U);
+    if ((entry->flags & SOUND_F_PCM_CACHE) != 0U)
+    {
+      sound_preload(entry->id);
+    }
   }
 }
 
@@ -0,0 +1,201 @@
+/*
+ * tilemap.c
+ *
+ * Tile background engine (see tilemap.h):
+ *  - Builds each row of a region from pre-shifted tile bytes, so the
+ *    renderer blits it byte aligned, and hands it over in row batches
+ *  - Scrolls by translating the layer and redrawing only the exposed strips
+ *
+ * Notes:
+ *  - Cost per frame is the strip area plus one plane shift of the view,
+ *    instead of a full redraw of the view.
+ */
+
+#include "tilemap.h"
+
+#include <stddef.h>
+
+/* ----------------------------- Tunables ---------------------------------- */
+
+#define TILEMAP_STRIP_BYTES (512U)  /* Row batch buffer handed to the blitter */
+
+static uint8_t s_strip[TILEMAP_STRIP_BYTES];
+
+/* ----------------------------- Helpers ----------------------------------- */
+
+static uint32_t wrap_mod(int32_t v, uint32_t m)
+{
+  int32_t r = v % (int32_t)m;
+  return (uint32_t)((r < 0) ? (r + (int32_t)m) : r);
+}
+
+static uint8_t tile_row_byte(const tilemap_t *tm, const uint8_t *map_row, uint32_t tx, uint32_t row)
+{
+  uint32_t idx = map_row[tx];
+  if (idx >= tm->tile_count)
+  {
+    idx = 0U;
+  }
+  return tm->tiles[(idx * TILEMAP_TILE_PIXELS) + row];
+}
+
+/*
+ * Fill `dst` with `count` bytes of world row `wy` starting at world column
+ * `wx`, shifted so bit 7 of dst[0] is pixel wx.
+ */
+static void build_row(const tilemap_t *tm, int32_t wx, int32_t wy, uint8_t *dst, uint32_t count)
+{
+  const uint32_t map_px_w = (uint32_t)tm->map_width * TILEMAP_TILE_PIXELS;
+  const uint32_t map_px_h = (uint32_t)tm->map_height * TILEMAP_TILE_PIXELS;
+  const uint32_t x = wrap_mod(wx, map_px_w);
+  const uint32_t y = wrap_mod(wy, map_px_h);
+  const uint8_t *map_row = &tm->map[(y / TILEMAP_TILE_PIXELS) * tm->map_width];
+  const uint32_t row = y % TILEMAP_TILE_PIXELS;
+  const uint32_t fine = x % TILEMAP_TILE_PIXELS;
+
+  uint32_t tx = x / TILEMAP_TILE_PIXELS;
+  uint8_t cur = tile_row_byte(tm, map_row, tx, row);
+
+  for (uint32_t k = 0U; k < count; ++k)
+  {
+    if (++tx == tm->map_width)
+    {
+      tx = 0U;
+    }
+    const uint8_t next = tile_row_byte(tm, map_row, tx, row);
+    dst[k] = (fine == 0U) ? cur : (uint8_t)((cur << fine) | (next >> (8U - fine)));
+    cur = next;
+  }
+}
+
+/* Draw the view-relative region [rx, rx + rw) x [ry, ry + rh) from the current scroll. */
+static void draw_region(const tilemap_t *tm, uint16_t rx, uint16_t ry, uint16_t rw, uint16_t rh)
+{
+  if ((rw == 0U) || (rh == 0U))
+  {
+    return;
+  }
+
+  const uint16_t stride = (uint16_t)((rw + 7U) / 8U);
+  const uint16_t batch_rows = (uint16_t)(TILEMAP_STRIP_BYTES / stride);
+  const int32_t wx = tm->scroll_x + rx;
+
+  for (uint16_t r0 = 0U; r0 < rh; r0 = (uint16_t)(r0 + batch_rows))
+  {
+    const uint16_t rows = ((rh - r0) < batch_rows) ? (uint16_t)(rh - r0) : batch_rows;
+    for (uint16_t r = 0U; r < rows; ++r)
+    {
+      build_row(tm, wx, tm->scroll_y + ry + r0 + r, &s_strip[(uint32_t)r * stride], stride);
+    }
+
+    renderBlit1bppMsbEx((int16_t)(tm->view.x + rx), (int16_t)(tm->view.y + ry + r0), rw, rows, s_strip,
+                        stride, 0U, tm->layer, RENDER_STATE_BLACK, RENDER_BLIT_OPAQUE);
+  }
+}
+
+/* ------------------------------ Public ----------------------------------- */
+
+void tilemap_init(tilemap_t *tm, const uint8_t *tiles, uint16_t tile_count, const uint8_t *map,
+                  uint16_t map_width, uint16_t map_height, render_layer_t layer, const render_rect_t *view)
+{
+  if (tm == NULL)
+  {
+    return;
+  }
+
+  tm->tiles = tiles;
+  tm->tile_count = tile_count;
+  tm->map = map;
+  tm->map_width = map_width;
+  tm->map_height = map_height;
+  tm->layer = layer;
+  if (view != NULL)
+  {
+    tm->view = *view;
+  }
+  else
+  {
+    tm->view.x = 0;
+    tm->view.y = 0;
+    tm->view.width = renderGetWidth();
+    tm->view.height = renderGetHeight();
+  }
+  tm->scroll_x = 0;
+  tm->scroll_y = 0;
+  tm->drawn_x = 0;
+  tm->drawn_y = 0;
+  tm->drawn = false;
+}
+
+void tilemap_set_scroll(tilemap_t *tm, int32_t x, int32_t y)
+{
+  if (tm == NULL)
+  {
+    return;
+  }
+
+  tm->scroll_x = x;
+  tm->scroll_y = y;
+}
+
+void tilemap_scroll_by(tilemap_t *tm, int32_t dx, int32_t dy)
+{
+  if (tm == NULL)
+  {
+    return;
+  }
+
+  tm->scroll_x += dx;
+  tm->scroll_y += dy;
+}
+
+void tilemap_invalidate(tilemap_t *tm)
+{
+  if (tm != NULL)
+  {
+    tm->drawn = false;
+  }
+}
+
+void tilemap_draw(tilemap_t *tm)
+{
+  if ((tm == NULL) || (tm->tiles == NULL) || (tm->map == NULL) || (tm->tile_count == 0U) ||
+      (tm->map_width == 0U) || (tm->map_height == 0U))
+  {
+    return;
+  }
+
+  const uint16_t w = tm->view.width;
+  const uint16_t h = tm->view.height;
+  if ((w == 0U) || (h == 0U) || (w > (TILEMAP_STRIP_BYTES * 8U)))
+  {
+    return;
+  }
+
+  /* Content moves against the scroll. */
+  const int32_t mdx = tm->drawn_x - tm->scroll_x;
+  const int32_t mdy = tm->drawn_y - tm->scroll_y;
+  const int32_t adx = (mdx < 0) ? -mdx : mdx;
+  const int32_t ady = (mdy < 0) ? -mdy : mdy;
+
+  if (!tm->drawn || (adx >= (int32_t)w) || (ady >= (int32_t)h))
+  {
+    draw_region(tm, 0U, 0U, w, h);
+  }
+  else if ((mdx != 0) || (mdy != 0))
+  {
+    renderScrollLayer(&tm->view, (int16_t)mdx, (int16_t)mdy, tm->layer);
+
+    /* Exposed columns over the full height, then exposed rows between them. */
+    const uint16_t col_x = (mdx > 0) ? 0U : (uint16_t)(w - adx);
+    draw_region(tm, col_x, 0U, (uint16_t)adx, h);
+
+    const uint16_t row_y = (mdy > 0) ? 0U : (uint16_t)(h - ady);
+    const uint16_t row_x = (mdx > 0) ? (uint16_t)adx : 0U;
+    draw_region(tm, row_x, row_y, (uint16_t)(w - adx), (uint16_t)ady);
+  }
+
+  tm->drawn_x = tm->scroll_x;
+  tm->drawn_y = tm->scroll_y;
+  tm->drawn = true;
+}
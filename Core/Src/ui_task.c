@@ -3,6 +3,7 @@
 #include "app_freertos.h"
 #include "audio_task.h"
 #include "cmsis_os2.h"
+#include "game_task.h"
 #include "render_demo.h"
 #include "settings.h"
 #include "sound_manager.h"
@@ -172,6 +173,7 @@ static void ui_enter_game(bool *resume_demo)
     if (ui_wait_for_mode(APP_MODE_GAME, 200U))
     {
       render_demo_set_mode(RENDER_DEMO_MODE_RUN);
+      game_task_wake();
       app_display_cmd_t cmd = APP_DISPLAY_CMD_RENDER_DEMO;
       (void)osMessageQueuePut(qDisplayCmdHandle, &cmd, 0U, 0U);
       *resume_demo = false;
@@ -376,6 +378,8 @@ void ui_task_run(void)
 
       if (ui_wait_for_mode(APP_MODE_GAME, 200U))
       {
+        /* Only once game mode is set: tskGame stops a demo outside it. */
+        game_task_wake();
         app_display_cmd_t display_cmd = APP_DISPLAY_CMD_RENDER_DEMO;
         (void)osMessageQueuePut(qDisplayCmdHandle, &display_cmd, 0U, 0U);
       }
@@ -0,0 +1,293 @@
+/*
+ * audio_adpcm_ref.c
+ *
+ * Reference decoders for Host/test_audio_adpcm.c: the per-sample IMA-ADPCM
+ * decoders audio_task.c had before the block decoders in audio_adpcm.c,
+ * with the WAV and stream state passed in instead of read from globals.
+ * One fix is applied: the streamed decoder used to drop the last code of
+ * every block (see ref_adpcm_stream_next_sample). Do not optimize it; its
+ * value is that it is the old code.
+ */
+
+#include "audio_adpcm_ref.h"
+
+#include "storage_task.h"
+
+#include <stddef.h>
+
+static const int16_t kImaStepTable[89] =
+{
+  7, 8, 9, 10, 11, 12, 13, 14,
+  16, 17, 19, 21, 23, 25, 28, 31,
+  34, 37, 41, 45, 50, 55, 60, 66,
+  73, 80, 88, 97, 107, 118, 130, 143,
+  157, 173, 190, 209, 230, 253, 279, 307,
+  337, 371, 408, 449, 494, 544, 598, 658,
+  724, 796, 876, 963, 1060, 1166, 1282, 1411,
+  1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024,
+  3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484,
+  7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+  15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+  32767
+};
+
+static const int8_t kImaIndexTable[16] =
+{
+  -1, -1, -1, -1, 2, 4, 6, 8,
+  -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+static uint16_t audio_read_u16_le(const uint8_t *data)
+{
+  return (uint16_t)data[0] | (uint16_t)((uint16_t)data[1] << 8);
+}
+
+static uint8_t ref_adpcm_begin_block(const wav_info_t *wav, adpcm_state_t *state)
+{
+  if ((wav == NULL) || (state == NULL))
+  {
+    return 0U;
+  }
+
+  if ((state->data_offset + wav->block_align) > wav->data_bytes)
+  {
+    return 0U;
+  }
+
+  const uint8_t *block = &wav->data[state->data_offset];
+  state->predictor = (int16_t)audio_read_u16_le(block);
+  state->index = block[2];
+  if (state->index > 88U)
+  {
+    state->index = 88U;
+  }
+  state->byte_offset = state->data_offset + 4U;
+  state->block_end = state->data_offset + wav->block_align;
+  state->samples_left = wav->samples_per_block;
+  state->nibble_high = 0U;
+  state->data_offset = state->block_end;
+  return 1U;
+}
+
+uint8_t ref_adpcm_next_sample(const wav_info_t *wav, adpcm_state_t *state, int16_t *out)
+{
+  if ((wav == NULL) || (state == NULL) || (out == NULL))
+  {
+    return 0U;
+  }
+
+  if (state->samples_left == 0U)
+  {
+    if (ref_adpcm_begin_block(wav, state) == 0U)
+    {
+      return 0U;
+    }
+  }
+
+  if (state->samples_left == wav->samples_per_block)
+  {
+    state->samples_left--;
+    *out = state->predictor;
+    return 1U;
+  }
+
+  if (state->byte_offset >= state->block_end)
+  {
+    state->samples_left = 0U;
+    return 0U;
+  }
+
+  uint8_t code;
+  if (state->nibble_high == 0U)
+  {
+    code = wav->data[state->byte_offset] & 0x0FU;
+    state->nibble_high = 1U;
+  }
+  else
+  {
+    code = (wav->data[state->byte_offset] >> 4) & 0x0FU;
+    state->nibble_high = 0U;
+    state->byte_offset++;
+  }
+
+  int32_t predictor = state->predictor;
+  int32_t step = kImaStepTable[state->index];
+  int32_t diff = step >> 3;
+  if ((code & 1U) != 0U)
+  {
+    diff += step >> 2;
+  }
+  if ((code & 2U) != 0U)
+  {
+    diff += step >> 1;
+  }
+  if ((code & 4U) != 0U)
+  {
+    diff += step;
+  }
+  if ((code & 8U) != 0U)
+  {
+    predictor -= diff;
+  }
+  else
+  {
+    predictor += diff;
+  }
+
+  if (predictor > 32767)
+  {
+    predictor = 32767;
+  }
+  else if (predictor < -32768)
+  {
+    predictor = -32768;
+  }
+
+  state->predictor = (int16_t)predictor;
+
+  int32_t index = (int32_t)state->index + (int32_t)kImaIndexTable[code];
+  if (index < 0)
+  {
+    index = 0;
+  }
+  else if (index > 88)
+  {
+    index = 88;
+  }
+  state->index = (uint8_t)index;
+
+  state->samples_left--;
+  *out = state->predictor;
+  return 1U;
+}
+
+uint8_t ref_adpcm_stream_next_sample(adpcm_stream_state_t *state, const wav_info_t *wav, uint32_t *bytes_left,
+                                     int16_t *out, uint8_t *done)
+{
+  if ((state == NULL) || (out == NULL))
+  {
+    return 0U;
+  }
+
+  if (done != NULL)
+  {
+    *done = 0U;
+  }
+
+  if (state->samples_left == 0U)
+  {
+    if (*bytes_left < wav->block_align)
+    {
+      if (done != NULL)
+      {
+        *done = 1U;
+      }
+      return 0U;
+    }
+
+    if (storage_stream_available() < 4U)
+    {
+      return 0U;
+    }
+
+    uint8_t header[4];
+    if (storage_stream_read(header, (uint32_t)sizeof(header)) != (uint32_t)sizeof(header))
+    {
+      return 0U;
+    }
+
+    state->predictor = (int16_t)((uint16_t)header[0] | ((uint16_t)header[1] << 8));
+    state->index = header[2];
+    if (state->index > 88U)
+    {
+      state->index = 88U;
+    }
+    state->samples_left = wav->samples_per_block;
+    state->block_bytes_left = (uint16_t)(wav->block_align - 4U);
+    state->nibble_high = 0U;
+    state->cur_byte = 0U;
+    *bytes_left -= wav->block_align;
+
+    state->samples_left--;
+    *out = state->predictor;
+    return 1U;
+  }
+
+  /* The one change from the original: let the high nibble of the last byte out. */
+  if ((state->block_bytes_left == 0U) && (state->nibble_high == 0U))
+  {
+    state->samples_left = 0U;
+    return 0U;
+  }
+
+  uint8_t code;
+  if (state->nibble_high == 0U)
+  {
+    if (storage_stream_available() < 1U)
+    {
+      return 0U;
+    }
+    if (storage_stream_read(&state->cur_byte, 1U) != 1U)
+    {
+      return 0U;
+    }
+    state->block_bytes_left--;
+    code = state->cur_byte & 0x0FU;
+    state->nibble_high = 1U;
+  }
+  else
+  {
+    code = (state->cur_byte >> 4) & 0x0FU;
+    state->nibble_high = 0U;
+  }
+
+  int32_t predictor = state->predictor;
+  int32_t step = kImaStepTable[state->index];
+  int32_t diff = step >> 3;
+  if ((code & 1U) != 0U)
+  {
+    diff += step >> 2;
+  }
+  if ((code & 2U) != 0U)
+  {
+    diff += step >> 1;
+  }
+  if ((code & 4U) != 0U)
+  {
+    diff += step;
+  }
+  if ((code & 8U) != 0U)
+  {
+    predictor -= diff;
+  }
+  else
+  {
+    predictor += diff;
+  }
+
+  if (predictor > 32767)
+  {
+    predictor = 32767;
+  }
+  else if (predictor < -32768)
+  {
+    predictor = -32768;
+  }
+
+  state->predictor = (int16_t)predictor;
+
+  int32_t index = (int32_t)state->index + (int32_t)kImaIndexTable[code];
+  if (index < 0)
+  {
+    index = 0;
+  }
+  else if (index > 88)
+  {
+    index = 88;
+  }
+  state->index = (uint8_t)index;
+
+  state->samples_left--;
+  *out = state->predictor;
+  return 1U;
+}
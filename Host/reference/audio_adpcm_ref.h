@@ -0,0 +1,16 @@
+#ifndef AUDIO_ADPCM_REF_H
+#define AUDIO_ADPCM_REF_H
+
+#include "audio_adpcm.h"
+
+#include <stdint.h>
+
+/*
+ * The per-sample decoders audio_adpcm.c replaced (audio_adpcm_ref.c).
+ * Each call returns 1 and one sample in `out`, or 0 when there is none.
+ */
+uint8_t ref_adpcm_next_sample(const wav_info_t *wav, adpcm_state_t *state, int16_t *out);
+uint8_t ref_adpcm_stream_next_sample(adpcm_stream_state_t *state, const wav_info_t *wav, uint32_t *bytes_left,
+                                     int16_t *out, uint8_t *done);
+
+#endif /* AUDIO_ADPCM_REF_H */
@@ -0,0 +1,55 @@
+#ifndef DISPLAY_RENDERER_L8_H
+#define DISPLAY_RENDERER_L8_H
+
+/*
+ * Byte-per-pixel reference renderer (display_renderer_l8.c). Same types and
+ * semantics as display_renderer.h for the calls it had; renderGetBuffer()
+ * returns plain rows of LINE_WIDTH bytes rather than the LCD stream layout.
+ */
+#include "display_renderer.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+void l8RenderInit(void);
+const uint8_t *l8RenderGetBuffer(void);
+bool l8RenderTakeDirtyRows(uint16_t *rows, uint16_t max_rows, uint16_t *out_count, bool *out_full);
+void l8RenderMarkDirtyRows(uint16_t start_row, uint16_t end_row);
+void l8RenderMarkDirtyList(const uint16_t *rows, uint16_t row_count);
+
+void l8RenderSetRotation(render_rotation_t rotation);
+render_rotation_t l8RenderGetRotation(void);
+uint16_t l8RenderGetWidth(void);
+uint16_t l8RenderGetHeight(void);
+
+void l8RenderFill(bool fill);
+void l8RenderInvert(void);
+void l8RenderFillRows(uint16_t start_row, uint16_t end_row, bool fill);
+void l8RenderInvertRows(uint16_t start_row, uint16_t end_row);
+void l8RenderSetPixel(uint16_t x, uint16_t y, render_layer_t layer, render_state_t state);
+void l8RenderDrawHLine(uint16_t x, uint16_t y, uint16_t length, render_layer_t layer, render_state_t state);
+void l8RenderDrawVLine(uint16_t x, uint16_t y, uint16_t length, render_layer_t layer, render_state_t state);
+void l8RenderFillRect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, render_layer_t layer,
+                      render_state_t state);
+void l8RenderDrawRect(uint16_t x, uint16_t y, uint16_t width, uint16_t height, render_layer_t layer,
+                      render_state_t state);
+void l8RenderDrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, render_layer_t layer,
+                      render_state_t state);
+void l8RenderDrawLineThick(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t thickness,
+                           render_layer_t layer, render_state_t state);
+void l8RenderDrawCircle(uint16_t x0, uint16_t y0, uint16_t radius, render_layer_t layer, render_state_t state);
+void l8RenderDrawCircleThick(uint16_t x0, uint16_t y0, uint16_t radius, uint16_t thickness, render_layer_t layer,
+                             render_state_t state);
+void l8RenderFillCircle(uint16_t x0, uint16_t y0, uint16_t radius, render_layer_t layer, render_state_t state);
+void l8RenderDrawChar(uint16_t x, uint16_t y, char ch, render_layer_t layer, render_state_t fg);
+void l8RenderDrawText(uint16_t x, uint16_t y, const char *text, render_layer_t layer, render_state_t fg);
+void l8RenderBlit1bpp(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *data,
+                      uint16_t stride_bytes, render_layer_t layer, render_state_t fg);
+void l8RenderBlit1bppMsb(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t *data,
+                         uint16_t stride_bytes, render_layer_t layer, render_state_t fg);
+void l8RenderDrawCharScaled(uint16_t x, uint16_t y, char ch, uint8_t scale, render_layer_t layer,
+                            render_state_t fg);
+void l8RenderDrawTextScaled(uint16_t x, uint16_t y, const char *text, uint8_t scale, render_layer_t layer,
+                            render_state_t fg);
+
+#endif /* DISPLAY_RENDERER_L8_H */
@@ -0,0 +1,244 @@
+/*
+ * render_bench_host.c
+ *
+ * Host runner for the render_bench.c cases:
+ *  - Times every case once per render_rotation_t, best of BENCH_REPEATS
+ *  - Logs ns/op and pixels/s per case, plus host cycles/op (TSC on x86,
+ *    otherwise derived from ns at 1 GHz) and one cycle total per rotation,
+ *    the figure to track for regressions
+ *  - Then the host-only cube transform cases: the float math render_demo
+ *    used to run (xform_f32) against the fixed3d path that replaced it
+ *    (xform_q16), 64 vertices per op; their rate column counts vertices
+ *
+ * Usage: render_bench_host [--scale N] [--quick]
+ *   --scale N  run N times each case's on-target iteration count (default 20)
+ *   --quick    one pass at scale 1, as a smoke test
+ *
+ * Notes:
+ *  - Host numbers rank changes; they are not Cortex-M33 cycles. Use the
+ *    on-target run (RENDER_BENCH=1) for absolute figures.
+ */
+
+#include "render_bench.h"
+
+#include "display_renderer.h"
+#include "fixed3d.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+  #include <x86intrin.h>
+  #define BENCH_HAVE_TSC 1
+#else
+  #define BENCH_HAVE_TSC 0
+#endif
+
+#define BENCH_REPEATS        (5U)
+#define BENCH_DEFAULT_SCALE  (20U)
+#define BENCH_XFORM_POINTS   (64U)
+#define BENCH_XFORM_FOCAL    (84)
+
+typedef struct { float x, y, z; } bench_vec3f_t;
+
+static bench_vec3f_t  s_xform_f32[BENCH_XFORM_POINTS];
+static fx3d_vec3_t    s_xform_q16[BENCH_XFORM_POINTS];
+static render_point_t s_xform_out[BENCH_XFORM_POINTS];
+
+static uint64_t bench_now_ns(void)
+{
+  struct timespec ts;
+  (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t bench_now_cycles(void)
+{
+#if BENCH_HAVE_TSC
+  return __rdtsc();
+#else
+  return bench_now_ns();
+#endif
+}
+
+/* Rotate about Y then X and project, as render_demo did before fixed3d. */
+static uint32_t bench_xform_f32(uint32_t iter, uint16_t width, uint16_t height)
+{
+  const float a = (float)iter * 0.045f;
+  const float cy = cosf(a);
+  const float sy = sinf(a);
+  const float cx = cosf(a * 0.6f);
+  const float sx = sinf(a * 0.6f);
+  const float ox = (float)(width / 2U);
+  const float oy = (float)(height / 2U);
+
+  for (uint32_t i = 0U; i < BENCH_XFORM_POINTS; ++i)
+  {
+    const bench_vec3f_t *v = &s_xform_f32[i];
+    const float xx = (v->x * cy) + (v->z * sy);
+    const float zz = (-v->x * sy) + (v->z * cy);
+    const float y = (v->y * cx) - (zz * sx);
+    float z = (v->y * sx) + (zz * cx) + 2.3f;
+    if (z < 0.25f)
+    {
+      z = 0.25f;
+    }
+
+    const float px = ox + ((float)BENCH_XFORM_FOCAL * xx) / z;
+    const float py = oy - ((float)BENCH_XFORM_FOCAL * y) / z;
+    s_xform_out[i].x = (int16_t)((px >= 0.0f) ? (px + 0.5f) : (px - 0.5f));
+    s_xform_out[i].y = (int16_t)((py >= 0.0f) ? (py + 0.5f) : (py - 0.5f));
+  }
+  return BENCH_XFORM_POINTS;
+}
+
+static uint32_t bench_xform_q16(uint32_t iter, uint16_t width, uint16_t height)
+{
+  static fx3d_vec3_t rotated[BENCH_XFORM_POINTS];
+  const fx3d_angle_t a = (fx3d_angle_t)(iter * FX3D_ANGLE_RAD(0.045));
+  const fx3d_camera_t cam =
+  {
+    .z_offset = Q16_C(2.3),
+    .near_z   = Q16_C(0.25),
+    .focal    = BENCH_XFORM_FOCAL,
+    .cx       = (int16_t)(width / 2U),
+    .cy       = (int16_t)(height / 2U)
+  };
+  fx3d_mat3_t rot;
+
+  fx3d_mat3_rot_yx(&rot, a, (fx3d_angle_t)(((uint32_t)a * 3U) / 5U));
+  fx3d_transform_points(&rot, s_xform_q16, rotated, BENCH_XFORM_POINTS);
+  fx3d_project_points(&cam, rotated, s_xform_out, BENCH_XFORM_POINTS);
+  return BENCH_XFORM_POINTS;
+}
+
+static const render_bench_case_t kXformCases[] =
+{
+  { "xform_f32",  200U, bench_xform_f32 },
+  { "xform_q16",  200U, bench_xform_q16 }
+};
+
+/* Points on a cube of half extent 0.6, in both representations. */
+static void bench_prepare_points(void)
+{
+  for (uint32_t i = 0U; i < BENCH_XFORM_POINTS; ++i)
+  {
+    const int32_t ix = (int32_t)(i & 3U) - 2;
+    const int32_t iy = (int32_t)((i >> 2U) & 3U) - 2;
+    const int32_t iz = (int32_t)((i >> 4U) & 3U) - 2;
+
+    s_xform_f32[i].x = (float)ix * 0.3f;
+    s_xform_f32[i].y = (float)iy * 0.3f;
+    s_xform_f32[i].z = (float)iz * 0.3f;
+    s_xform_q16[i].x = ix * Q16_C(0.3);
+    s_xform_q16[i].y = iy * Q16_C(0.3);
+    s_xform_q16[i].z = iz * Q16_C(0.3);
+  }
+}
+
+/* Time one case, best of `repeats`, log it and return its cycles/op. */
+static uint64_t bench_time_case(const render_bench_case_t *bench, uint32_t scale, uint32_t repeats,
+                                render_rotation_t rotation)
+{
+  const uint16_t width = renderGetWidth();
+  const uint16_t height = renderGetHeight();
+  const uint32_t ops = bench->iterations * scale;
+  uint64_t best_ns = UINT64_MAX;
+  uint64_t best_cycles = UINT64_MAX;
+  uint64_t pixels = 0U;
+
+  for (uint32_t rep = 0U; rep < repeats; ++rep)
+  {
+    renderFill(false);
+    pixels = 0U;
+    uint64_t start_ns = bench_now_ns();
+    uint64_t start_cycles = bench_now_cycles();
+    for (uint32_t i = 0U; i < ops; ++i)
+    {
+      pixels += bench->fn(i % bench->iterations, width, height);
+    }
+    uint64_t cycles = bench_now_cycles() - start_cycles;
+    uint64_t ns = bench_now_ns() - start_ns;
+    if (ns < best_ns)
+    {
+      best_ns = ns;
+    }
+    if (cycles < best_cycles)
+    {
+      best_cycles = cycles;
+    }
+  }
+
+  const double ns_per_op = (double)best_ns / (double)ops;
+  const double px_per_s = (best_ns != 0U) ? ((double)pixels * 1e9) / (double)best_ns : 0.0;
+  const uint64_t cyc_per_op = best_cycles / ops;
+  printf("bench rot=%u %-10s %10.1f ns/op %14.0f px/s %10llu cyc/op\n",
+         (unsigned)rotation, bench->name, ns_per_op, px_per_s, (unsigned long long)cyc_per_op);
+  return cyc_per_op;
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t scale = BENCH_DEFAULT_SCALE;
+  uint32_t repeats = BENCH_REPEATS;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    if ((strcmp(argv[i], "--scale") == 0) && ((i + 1) < argc))
+    {
+      scale = (uint32_t)strtoul(argv[++i], NULL, 10);
+      if (scale == 0U)
+      {
+        scale = 1U;
+      }
+    }
+    else if (strcmp(argv[i], "--quick") == 0)
+    {
+      scale = 1U;
+      repeats = 1U;
+    }
+    else
+    {
+      fprintf(stderr, "usage: %s [--scale N] [--quick]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  uint32_t case_count = 0U;
+  const render_bench_case_t *cases = render_bench_cases(&case_count);
+
+  renderInit();
+  render_bench_begin();
+  bench_prepare_points();
+
+  printf("bench start host scale=%u repeats=%u clock=%s\n", (unsigned)scale, (unsigned)repeats,
+         BENCH_HAVE_TSC ? "tsc" : "ns");
+
+  for (uint32_t r = (uint32_t)RENDER_ROTATION_0; r <= (uint32_t)RENDER_ROTATION_270_CW; ++r)
+  {
+    render_rotation_t rotation = (render_rotation_t)r;
+    renderSetRotation(rotation);
+
+    uint64_t total = 0U;
+    for (uint32_t c = 0U; c < case_count; ++c)
+    {
+      total += bench_time_case(&cases[c], scale, repeats, rotation);
+    }
+
+    printf("bench rot=%u total %llu cyc\n", (unsigned)rotation, (unsigned long long)total);
+  }
+
+  /* The transform cases do not draw, so one rotation is enough. */
+  renderSetRotation(RENDER_ROTATION_270_CW);
+  for (uint32_t c = 0U; c < (uint32_t)(sizeof(kXformCases) / sizeof(kXformCases[0])); ++c)
+  {
+    (void)bench_time_case(&kXformCases[c], scale, repeats, RENDER_ROTATION_270_CW);
+  }
+
+  render_bench_end();
+  return 0;
+}
@@ -0,0 +1,205 @@
+/*
+ * render_check_host.c
+ *
+ * Host runner for the render_check.c scenarios:
+ *  - Renders every scenario (each UI page, the sleep face, demo frames
+ *    0..7) against the boot-state stand-ins in stubs/ui_stubs.c
+ *  - Compares each packed frame bit for bit with Host/golden/<name>.pbm and
+ *    its CRC with the golden in the scenario table; a missing PBM or a
+ *    golden of 0 ("new") is a failure, as on target
+ *  - Logs the verdict and the render time per scenario, best of
+ *    CHECK_REPEATS draws
+ *  - A frame that does not match is written next to the build as
+ *    <name>.actual.pbm for review
+ *
+ * Usage: render_check_host [--golden DIR] [--update]
+ *   --golden DIR  read the PBMs from DIR (default: Host/golden)
+ *   --update      write every frame to DIR as its golden and print the CRCs
+ *                 to record in kCheckScenarios; review the images first
+ */
+
+#include "render_check.h"
+
+#include "display_renderer.h"
+#include "host_stubs.h"
+#include "settings.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef RENDER_CHECK_GOLDEN_DIR
+#define RENDER_CHECK_GOLDEN_DIR "golden"
+#endif
+
+#define CHECK_REPEATS    (20U)
+#define CHECK_PATH_MAX   (512U)
+#define CHECK_PBM_HEADER_MAX (32U)
+#define CHECK_PBM_MAX    (CHECK_PBM_HEADER_MAX + (LINE_WIDTH * DISPLAY_HEIGHT))
+
+static uint8_t s_pbm[CHECK_PBM_MAX];
+static uint8_t s_golden[CHECK_PBM_MAX + 1U];
+
+static uint64_t check_now_ns(void)
+{
+  struct timespec ts;
+  (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/* P4 image of a packed frame; returns its length in bytes. */
+static uint32_t check_frame_to_pbm(const uint8_t *frame)
+{
+  int header = snprintf((char *)s_pbm, CHECK_PBM_HEADER_MAX, "P4\n%u %u\n", (unsigned)DISPLAY_WIDTH,
+                        (unsigned)DISPLAY_HEIGHT);
+  uint32_t len = (uint32_t)header;
+  for (uint16_t row = 1U; row <= DISPLAY_HEIGHT; ++row)
+  {
+    render_check_pbm_row(frame, row, &s_pbm[len]);
+    len += LINE_WIDTH;
+  }
+  return len;
+}
+
+static bool check_write_file(const char *path, const uint8_t *data, uint32_t len)
+{
+  FILE *f = fopen(path, "wb");
+  if (f == NULL)
+  {
+    return false;
+  }
+  bool ok = (fwrite(data, 1U, len, f) == len);
+  ok = (fclose(f) == 0) && ok;
+  return ok;
+}
+
+/* Returns the golden's length, or -1 if it cannot be read. */
+static int32_t check_read_golden(const char *path)
+{
+  FILE *f = fopen(path, "rb");
+  if (f == NULL)
+  {
+    return -1;
+  }
+  size_t len = fread(s_golden, 1U, sizeof(s_golden), f);
+  (void)fclose(f);
+  return (int32_t)len;
+}
+
+int main(int argc, char **argv)
+{
+  const char *golden_dir = RENDER_CHECK_GOLDEN_DIR;
+  bool update = false;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    if ((strcmp(argv[i], "--golden") == 0) && ((i + 1) < argc))
+    {
+      golden_dir = argv[++i];
+    }
+    else if (strcmp(argv[i], "--update") == 0)
+    {
+      update = true;
+    }
+    else
+    {
+      fprintf(stderr, "usage: %s [--golden DIR] [--update]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  uint32_t total = 0U;
+  const render_check_scenario_t *scenarios = render_check_scenarios(&total);
+  uint32_t failed = 0U;
+  uint32_t unrecorded = 0U;
+
+  host_set_tick_ms(0U);
+  settings_init();
+
+  for (uint32_t i = 0U; i < total; ++i)
+  {
+    const render_check_scenario_t *sc = &scenarios[i];
+    char path[CHECK_PATH_MAX];
+    (void)snprintf(path, sizeof(path), "%s/%s.pbm", golden_dir, sc->name);
+
+    /* The first draw is the one checked; the repeats only time it. */
+    uint64_t start = check_now_ns();
+    render_check_draw(sc);
+    uint64_t best_ns = check_now_ns() - start;
+
+    uint32_t crc = 0U;
+    const uint8_t *frame = render_check_pack(&crc);
+    if (frame == NULL)
+    {
+      printf("check %-13s FAIL(pack)\n", sc->name);
+      ++failed;
+      continue;
+    }
+    uint32_t pbm_len = check_frame_to_pbm(frame);
+
+    for (uint32_t r = 0U; r < CHECK_REPEATS; ++r)
+    {
+      start = check_now_ns();
+      render_check_draw(sc);
+      uint64_t elapsed = check_now_ns() - start;
+      if (elapsed < best_ns)
+      {
+        best_ns = elapsed;
+      }
+    }
+
+    const char *verdict;
+    if (update)
+    {
+      if (check_write_file(path, s_pbm, pbm_len))
+      {
+        verdict = "written";
+      }
+      else
+      {
+        verdict = "FAIL(write)";
+        ++failed;
+      }
+    }
+    else
+    {
+      int32_t golden_len = check_read_golden(path);
+      if ((golden_len < 0) || (sc->golden == 0U))
+      {
+        verdict = "new";
+        ++unrecorded;
+        ++failed;
+      }
+      else if (((uint32_t)golden_len != pbm_len) || (memcmp(s_golden, s_pbm, pbm_len) != 0))
+      {
+        verdict = "FAIL";
+        ++failed;
+      }
+      else if (crc != sc->golden)
+      {
+        /* Image matches, table does not: the CRC was not updated with the PBM. */
+        verdict = "FAIL(crc)";
+        ++failed;
+      }
+      else
+      {
+        verdict = "ok";
+      }
+
+      if (strcmp(verdict, "ok") != 0)
+      {
+        char actual[CHECK_PATH_MAX];
+        (void)snprintf(actual, sizeof(actual), "%s.actual.pbm", sc->name);
+        (void)check_write_file(actual, s_pbm, pbm_len);
+      }
+    }
+
+    printf("check %-13s 0x%08X %-11s %9.1f us\n", sc->name, (unsigned)crc, verdict, (double)best_ns / 1000.0);
+  }
+
+  printf("check done %u/%u failed (%u new)\n", (unsigned)failed, (unsigned)total, (unsigned)unrecorded);
+  render_check_end();
+  return (failed == 0U) ? 0 : 1;
+}
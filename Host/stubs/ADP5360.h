@@ -0,0 +1,2 @@
+/* The firmware includes adp5360.h by this name; case-sensitive hosts need the alias. */
+#include "adp5360.h"
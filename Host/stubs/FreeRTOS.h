@@ -0,0 +1,13 @@
+/*
+ * Host stand-in for FreeRTOS.h. Host-built sources only reach it through
+ * app_freertos.h, which needs only the types.
+ */
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+
+#endif /* HOST_FREERTOS_H */
@@ -0,0 +1,83 @@
+/*
+ * host_stubs.c
+ *
+ * Host stand-ins for the firmware the host-built sources call into: the
+ * CMSIS-RTOS2 tick and mutexes, the RTC, the power task's perf mode and the
+ * LCD driver's stream framing. Values are fixed so runs are reproducible.
+ */
+
+#include "host_stubs.h"
+
+#include "LS013B7DH05.h"
+#include "power_task.h"
+#include "stm32u5xx_hal.h"
+
+#include "cmsis_os2.h"
+
+#include <stddef.h>
+
+static uint32_t s_tick_ms = 0U;
+
+RTC_HandleTypeDef hrtc;
+
+void host_set_tick_ms(uint32_t now_ms)
+{
+  s_tick_ms = now_ms;
+}
+
+uint32_t osKernelGetTickCount(void)
+{
+  return s_tick_ms;
+}
+
+/* Single-threaded on the host: nothing to wait for. */
+osStatus_t osMutexAcquire(osMutexId_t mutex_id, uint32_t timeout)
+{
+  return osOK;
+}
+
+osStatus_t osMutexRelease(osMutexId_t mutex_id)
+{
+  return osOK;
+}
+
+/* 2025-01-01 12:34:56, a Wednesday. */
+HAL_StatusTypeDef HAL_RTC_GetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *sTime, uint32_t Format)
+{
+  sTime->Hours = 12U;
+  sTime->Minutes = 34U;
+  sTime->Seconds = 56U;
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RTC_GetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *sDate, uint32_t Format)
+{
+  sDate->WeekDay = 3U;
+  sDate->Month = 1U;
+  sDate->Date = 1U;
+  sDate->Year = 25U;
+  return HAL_OK;
+}
+
+power_perf_mode_t power_task_get_perf_mode(void)
+{
+  return POWER_PERF_MODE_CRUISE;
+}
+
+/* Same framing as LS013B7DH05.c. */
+void LCD_StreamInit(uint8_t *stream)
+{
+  if (stream == NULL)
+  {
+    return;
+  }
+
+  stream[0] = 0x01U;
+  for (uint16_t r = 1U; r <= DISPLAY_HEIGHT; r++)
+  {
+    uint8_t *line = &stream[LCD_STREAM_LINE_OFFSET(r)];
+    line[0] = (uint8_t)r;
+    line[1U + LINE_WIDTH] = 0x00U;
+  }
+  stream[LCD_STREAM_LENGTH - 1U] = 0x00U;
+}
@@ -0,0 +1,12 @@
+#ifndef HOST_STUBS_H
+#define HOST_STUBS_H
+
+#include <stdint.h>
+
+/*
+ * Controls for the host stand-ins in host_stubs.c. The RTOS tick only moves
+ * when a host program sets it, so every run sees the same timebase.
+ */
+void host_set_tick_ms(uint32_t now_ms);
+
+#endif /* HOST_STUBS_H */
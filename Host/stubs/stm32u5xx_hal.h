@@ -0,0 +1,81 @@
+/*
+ * Host stand-in for the STM32U5 HAL and CMSIS core headers.
+ *
+ * Provides only what the host-built sources reference: the HAL handle and
+ * status types named in driver headers, and portable C versions of the
+ * CMSIS intrinsics the renderer and audio decoder use. Nothing here talks to
+ * hardware.
+ */
+#ifndef HOST_STM32U5XX_HAL_H
+#define HOST_STM32U5XX_HAL_H
+
+#include <stdint.h>
+
+typedef enum
+{
+  HAL_OK = 0x00U,
+  HAL_ERROR = 0x01U,
+  HAL_BUSY = 0x02U,
+  HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+typedef struct { uint32_t unused; } SPI_HandleTypeDef;
+typedef struct { uint32_t unused; } I2C_HandleTypeDef;
+typedef struct { uint32_t unused; } RTC_HandleTypeDef;
+typedef struct { uint32_t unused; } GPIO_TypeDef;
+
+#define RTC_FORMAT_BIN 0x00000000U
+
+typedef struct
+{
+  uint8_t Hours;
+  uint8_t Minutes;
+  uint8_t Seconds;
+} RTC_TimeTypeDef;
+
+typedef struct
+{
+  uint8_t WeekDay;
+  uint8_t Month;
+  uint8_t Date;
+  uint8_t Year;
+} RTC_DateTypeDef;
+
+/* Host RTC: a fixed date and time, see host_stubs.c. */
+HAL_StatusTypeDef HAL_RTC_GetTime(RTC_HandleTypeDef *hrtc, RTC_TimeTypeDef *sTime, uint32_t Format);
+HAL_StatusTypeDef HAL_RTC_GetDate(RTC_HandleTypeDef *hrtc, RTC_DateTypeDef *sDate, uint32_t Format);
+
+/* ----------------------------- CMSIS intrinsics -------------------------- */
+
+static inline uint32_t __RBIT(uint32_t value)
+{
+  uint32_t result = 0U;
+  for (uint32_t i = 0U; i < 32U; ++i)
+  {
+    result = (result << 1U) | (value & 1U);
+    value >>= 1U;
+  }
+  return result;
+}
+
+static inline uint8_t __CLZ(uint32_t value)
+{
+  return (value == 0U) ? 32U : (uint8_t)__builtin_clz(value);
+}
+
+static inline uint32_t __REV(uint32_t value)
+{
+  return __builtin_bswap32(value);
+}
+
+static inline int32_t __SSAT(int32_t value, uint32_t sat)
+{
+  const int32_t max = (int32_t)((1UL << (sat - 1U)) - 1UL);
+  const int32_t min = -max - 1;
+  return (value > max) ? max : ((value < min) ? min : value);
+}
+
+#define __PKHBT(ARG1, ARG2, ARG3) \
+  ((((uint32_t)(ARG1)) & 0x0000FFFFUL) | ((((uint32_t)(ARG2)) << (ARG3)) & 0xFFFF0000UL))
+
+#endif /* HOST_STM32U5XX_HAL_H */
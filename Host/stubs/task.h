@@ -0,0 +1,10 @@
+/* Host stand-in for FreeRTOS task.h; see FreeRTOS.h. */
+#ifndef HOST_TASK_H
+#define HOST_TASK_H
+
+#include "FreeRTOS.h"
+
+typedef void *TaskHandle_t;
+typedef TaskHandle_t xTaskHandle;
+
+#endif /* HOST_TASK_H */
@@ -0,0 +1,2 @@
+/* The firmware includes TMAG_joy.h by this name; case-sensitive hosts need the alias. */
+#include "TMAG_joy.h"
@@ -0,0 +1,191 @@
+/*
+ * ui_stubs.c
+ *
+ * Host stand-ins for the tasks and drivers the UI pages read from, for the
+ * render check. Every getter reports the state a board has right after boot
+ * with nothing attached: no sensor samples yet, storage not mounted, no
+ * charger chip answering, boot volumes. Requests are accepted and dropped.
+ */
+
+#include "ADP5360.h"
+#include "audio_task.h"
+#include "power_task.h"
+#include "sensor_task.h"
+#include "sound_manager.h"
+#include "storage_task.h"
+#include "ui_actions.h"
+
+#include "cmsis_os2.h"
+
+#include <stddef.h>
+#include <string.h>
+
+/* settings.c takes this mutex only when it is not NULL. */
+osMutexId_t mtxSettingsHandle = NULL;
+
+static uint8_t s_volume = 7U;
+static uint8_t s_category_volume[SOUND_CAT_COUNT] = { 5U, 5U, 5U };
+
+/* ------------------------------ Sensors ---------------------------------- */
+
+void sensor_joy_get_status(sensor_joy_status_t *out)
+{
+  memset(out, 0, sizeof(*out));
+}
+
+void sensor_joy_get_menu_params(sensor_joy_menu_params_t *out)
+{
+  memset(out, 0, sizeof(*out));
+}
+
+void sensor_power_get_status(sensor_power_status_t *out)
+{
+  memset(out, 0, sizeof(*out));
+}
+
+void sensor_lis2_get_status(sensor_lis2_status_t *out)
+{
+  memset(out, 0, sizeof(*out));
+}
+
+/* ------------------------------ Charger ---------------------------------- */
+
+HAL_StatusTypeDef ADP5360_get_vbus_ilim(uint16_t *vADPichg_mV, ADP5360_vsys_t *vsys_mode, uint16_t *ilim_mA)
+{
+  return HAL_ERROR;
+}
+
+HAL_StatusTypeDef ADP5360_get_chg_term(uint16_t *vtrm_mV, uint16_t *itrk_deci_mA)
+{
+  return HAL_ERROR;
+}
+
+HAL_StatusTypeDef ADP5360_get_chg_current(uint16_t *iend_mA, uint16_t *ichg_mA)
+{
+  return HAL_ERROR;
+}
+
+HAL_StatusTypeDef ADP5360_get_bat_capacity(uint16_t *capacity_mAh)
+{
+  return HAL_ERROR;
+}
+
+/* ------------------------------ Storage ---------------------------------- */
+
+void storage_get_status(storage_status_t *out)
+{
+  memset(out, 0, sizeof(*out));
+}
+
+bool storage_request_remount(void)
+{
+  return false;
+}
+
+bool storage_request_test(void)
+{
+  return false;
+}
+
+bool storage_request_save_settings(void)
+{
+  return false;
+}
+
+bool storage_request_list(const char *path)
+{
+  return false;
+}
+
+bool storage_request_audio_list(void)
+{
+  return false;
+}
+
+bool storage_request_format_audio(void)
+{
+  return false;
+}
+
+bool storage_request_format_all(void)
+{
+  return false;
+}
+
+uint32_t storage_audio_list_count(void)
+{
+  return 0U;
+}
+
+uint32_t storage_audio_list_seq(void)
+{
+  return 0U;
+}
+
+uint8_t storage_audio_list_get(uint32_t index, storage_audio_entry_t *out)
+{
+  return 0U;
+}
+
+storage_seed_state_t storage_get_seed_state(void)
+{
+  return STORAGE_SEED_IDLE;
+}
+
+/* ---------------------------- Audio / power ------------------------------ */
+
+void audio_set_volume(uint8_t level)
+{
+  s_volume = level;
+}
+
+uint8_t audio_get_volume(void)
+{
+  return s_volume;
+}
+
+void audio_set_category_volume(sound_category_t category, uint8_t level)
+{
+  if ((uint32_t)category < SOUND_CAT_COUNT)
+  {
+    s_category_volume[category] = level;
+  }
+}
+
+uint8_t audio_get_category_volume(sound_category_t category)
+{
+  return ((uint32_t)category < SOUND_CAT_COUNT) ? s_category_volume[category] : 0U;
+}
+
+const sound_registry_entry_t *sound_registry_get_by_path(const char *path)
+{
+  return NULL;
+}
+
+void sound_play(sound_id_t id)
+{
+}
+
+void power_task_set_sleep_enabled(uint8_t enabled)
+{
+}
+
+void power_task_set_inactivity_timeout_ms(uint32_t timeout_ms)
+{
+}
+
+void power_task_set_sleepface_interval_s(uint32_t interval_s)
+{
+}
+
+void power_task_set_game_sleep_allowed(uint8_t allow)
+{
+}
+
+void power_task_request_rtc_set(const power_rtc_datetime_t *dt)
+{
+}
+
+void ui_actions_send_sensor_req(app_sensor_req_t req)
+{
+}
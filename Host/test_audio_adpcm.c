@@ -0,0 +1,257 @@
+/*
+ * test_audio_adpcm.c
+ *
+ * Differential test of the block IMA-ADPCM decoders (audio_adpcm.c) against
+ * the per-sample ones they replaced (reference/audio_adpcm_ref.c):
+ *  - Random mono IMA data: odd block sizes, short samples_per_block, stray
+ *    step indices above 88, a partial block at the end
+ *  - audio_adpcm_decode() in random chunk sizes, odd ones included, must
+ *    give the same samples as ref_adpcm_next_sample() up to the same end
+ *  - audio_adpcm_stream_decode() reads from a fake storage ring that is
+ *    topped up a random number of bytes (often none) between calls, so
+ *    reads split headers and bytes and underrun mid-block; the samples
+ *    must match ref_adpcm_stream_next_sample() and end with `done`
+ *
+ * Usage: test_audio_adpcm [streams] [seed]
+ */
+
+#include "audio_adpcm.h"
+#include "audio_adpcm_ref.h"
+#include "storage_task.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_DEFAULT_STREAMS  (2000U)
+#define TEST_DEFAULT_SEED     (88172645U)
+#define TEST_DATA_MAX         (8192U)
+#define TEST_SAMPLES_MAX      (2U * TEST_DATA_MAX)
+#define TEST_CHUNK_MAX        (300U)
+/* Calls in a row that may return nothing before the test calls it a hang. */
+#define TEST_STALL_MAX        (10000U)
+
+static uint8_t s_data[TEST_DATA_MAX];
+static int16_t s_expect[TEST_SAMPLES_MAX];
+static int16_t s_got[TEST_SAMPLES_MAX + TEST_CHUNK_MAX];
+static uint32_t s_rng = TEST_DEFAULT_SEED;
+
+/* Fake storage ring: s_data[s_ring_read .. s_ring_fill) is available. */
+static uint32_t s_ring_read;
+static uint32_t s_ring_fill;
+static uint32_t s_ring_size;
+
+uint32_t storage_stream_available(void)
+{
+  return s_ring_fill - s_ring_read;
+}
+
+uint32_t storage_stream_read(uint8_t *dst, uint32_t len)
+{
+  uint32_t n = storage_stream_available();
+  if (n > len)
+  {
+    n = len;
+  }
+  memcpy(dst, &s_data[s_ring_read], n);
+  s_ring_read += n;
+  return n;
+}
+
+static void ring_reset(uint32_t fill)
+{
+  s_ring_read = 0U;
+  s_ring_fill = (fill > s_ring_size) ? s_ring_size : fill;
+}
+
+static void ring_top_up(uint32_t bytes)
+{
+  s_ring_fill = ((s_ring_size - s_ring_fill) < bytes) ? s_ring_size : (s_ring_fill + bytes);
+}
+
+static uint32_t rng_next(void)
+{
+  s_rng ^= s_rng << 13U;
+  s_rng ^= s_rng >> 17U;
+  s_rng ^= s_rng << 5U;
+  return s_rng;
+}
+
+static uint32_t rng_below(uint32_t n)
+{
+  return rng_next() % n;
+}
+
+/* Chunk sizes the mixer could ask for, and odd ones it would not. */
+static uint32_t rng_chunk(void)
+{
+  switch (rng_below(4U))
+  {
+    case 0:
+      return 1U + rng_below(4U);
+    case 1:
+      return 128U;
+    default:
+      return 1U + rng_below(TEST_CHUNK_MAX);
+  }
+}
+
+static void random_wav(wav_info_t *wav)
+{
+  memset(wav, 0, sizeof(*wav));
+  wav->format = WAV_FORMAT_IMA_ADPCM;
+  wav->channels = 1U;
+  wav->bits_per_sample = 4U;
+  wav->sample_rate = 16000U;
+
+  static const uint16_t kAligns[] = { 256U, 512U, 36U };
+  wav->block_align = (rng_below(2U) == 0U) ? kAligns[rng_below(3U)] : (uint16_t)(5U + rng_below(300U));
+  const uint16_t max_spb = (uint16_t)(((wav->block_align - 4U) * 2U) + 1U);
+  wav->samples_per_block = (rng_below(4U) == 0U) ? (uint16_t)(1U + rng_below(max_spb)) : max_spb;
+
+  uint32_t blocks = rng_below((TEST_DATA_MAX / wav->block_align) + 1U);
+  uint32_t bytes = blocks * wav->block_align;
+  if ((rng_below(3U) == 0U) && ((bytes + wav->block_align) <= TEST_DATA_MAX))
+  {
+    bytes += rng_below(wav->block_align);
+  }
+  wav->data_bytes = bytes;
+  wav->data = s_data;
+
+  for (uint32_t i = 0U; i < bytes; ++i)
+  {
+    s_data[i] = (uint8_t)rng_next();
+  }
+  /* Mostly valid step indices in the block headers, now and then too large. */
+  for (uint32_t b = 0U; (b + wav->block_align) <= bytes; b += wav->block_align)
+  {
+    s_data[b + 2U] = (uint8_t)((rng_below(8U) == 0U) ? (89U + rng_below(167U)) : rng_below(89U));
+    s_data[b + 3U] = 0U;
+  }
+  s_ring_size = bytes;
+}
+
+static bool compare(const char *what, uint32_t n, uint32_t expect_count, uint32_t got_count)
+{
+  if (got_count != expect_count)
+  {
+    printf("FAIL %s decode, stream %u: %u samples, reference %u\n", what, (unsigned)n, (unsigned)got_count,
+           (unsigned)expect_count);
+    return false;
+  }
+  for (uint32_t i = 0U; i < expect_count; ++i)
+  {
+    if (s_got[i] != s_expect[i])
+    {
+      printf("FAIL %s decode, stream %u: sample %u is %d, reference %d\n", what, (unsigned)n, (unsigned)i,
+             s_got[i], s_expect[i]);
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool test_memory(uint32_t n, const wav_info_t *wav)
+{
+  adpcm_state_t ref;
+  uint32_t expect_count = 0U;
+  audio_adpcm_reset(&ref);
+  while ((expect_count < TEST_SAMPLES_MAX) && (ref_adpcm_next_sample(wav, &ref, &s_expect[expect_count]) != 0U))
+  {
+    expect_count++;
+  }
+
+  adpcm_state_t state;
+  uint32_t got_count = 0U;
+  audio_adpcm_reset(&state);
+  for (;;)
+  {
+    uint32_t want = rng_chunk();
+    uint32_t got = audio_adpcm_decode(wav, &state, &s_got[got_count], want);
+    got_count += got;
+    if ((got < want) || (got_count > TEST_SAMPLES_MAX))
+    {
+      break;
+    }
+  }
+  return compare("memory", n, expect_count, got_count);
+}
+
+static bool test_stream(uint32_t n, const wav_info_t *wav)
+{
+  adpcm_stream_state_t ref;
+  uint32_t ref_left = wav->data_bytes;
+  uint32_t expect_count = 0U;
+  uint8_t done = 0U;
+  ring_reset(s_ring_size);
+  audio_adpcm_stream_reset(&ref);
+  while (expect_count < TEST_SAMPLES_MAX)
+  {
+    if (ref_adpcm_stream_next_sample(&ref, wav, &ref_left, &s_expect[expect_count], &done) != 0U)
+    {
+      expect_count++;
+    }
+    else if ((done != 0U) || (storage_stream_available() == 0U))
+    {
+      break;
+    }
+  }
+
+  adpcm_stream_state_t state;
+  uint32_t left = wav->data_bytes;
+  uint32_t got_count = 0U;
+  uint32_t stalls = 0U;
+  done = 0U;
+  ring_reset(rng_below(16U));
+  audio_adpcm_stream_reset(&state);
+  while ((done == 0U) && (got_count <= TEST_SAMPLES_MAX))
+  {
+    uint32_t got = audio_adpcm_stream_decode(&state, wav, &left, &s_got[got_count], rng_chunk(), &done);
+    got_count += got;
+    stalls = (got == 0U) ? (stalls + 1U) : 0U;
+    if (stalls > TEST_STALL_MAX)
+    {
+      printf("FAIL stream %u: no progress with %u of %u bytes in the ring\n", (unsigned)n,
+             (unsigned)s_ring_fill, (unsigned)s_ring_size);
+      return false;
+    }
+    /* Storage lags behind about half the time; a bare trickle tests split reads. */
+    if (rng_below(2U) == 0U)
+    {
+      ring_top_up((rng_below(4U) == 0U) ? (1U + rng_below(3U)) : rng_below(200U));
+    }
+  }
+  return compare("stream", n, expect_count, got_count);
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t streams = TEST_DEFAULT_STREAMS;
+  if (argc > 1)
+  {
+    streams = (uint32_t)strtoul(argv[1], NULL, 10);
+  }
+  if (argc > 2)
+  {
+    s_rng = (uint32_t)strtoul(argv[2], NULL, 10);
+    if (s_rng == 0U)
+    {
+      s_rng = TEST_DEFAULT_SEED;
+    }
+  }
+
+  wav_info_t wav;
+  for (uint32_t n = 0U; n < streams; ++n)
+  {
+    random_wav(&wav);
+    if (!test_memory(n, &wav) || !test_stream(n, &wav))
+    {
+      return 1;
+    }
+  }
+
+  printf("ok: %u streams match the per-sample decoders\n", (unsigned)streams);
+  return 0;
+}
@@ -0,0 +1,380 @@
+/*
+ * test_render_planes.c
+ *
+ * Differential test of the bitplane compositor against the byte-per-pixel
+ * one it replaced (reference/display_renderer_l8.c):
+ *  - Drives both renderers with the same seeded random sequence of public
+ *    calls: every primitive, all layers and the solid states, clipped and
+ *    wrapped coordinates, rotations, fills, inverts and partial takes
+ *  - Applies the rows each one hands out to its own copy of the panel glass
+ *    and compares the two glasses bit for bit every TEST_CHECK_EVERY calls
+ *
+ * Usage: test_render_planes [calls] [seed]
+ *
+ * Notes:
+ *  - The renderers hand out different row sets (the planar one skips rows
+ *    whose line is unchanged), so the glasses are compared rather than the
+ *    row lists.
+ *  - Only calls the old renderer had are exercised, with states 0..2.
+ */
+
+#include "display_renderer.h"
+#include "display_renderer_l8.h"
+#include "font8x8_basic.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_DEFAULT_CALLS  (30000U)
+#define TEST_DEFAULT_SEED   (12345U)
+#define TEST_CHECK_EVERY    (50U)
+#define TEST_BITMAP_BYTES   (64U * 40U)
+
+static uint8_t s_glass[DISPLAY_HEIGHT][LINE_WIDTH];
+static uint8_t s_glass_l8[DISPLAY_HEIGHT][LINE_WIDTH];
+static uint8_t s_bitmap[TEST_BITMAP_BYTES];
+static uint32_t s_rng = TEST_DEFAULT_SEED;
+
+static uint32_t rng_next(void)
+{
+  s_rng ^= s_rng << 13U;
+  s_rng ^= s_rng >> 17U;
+  s_rng ^= s_rng << 5U;
+  return s_rng;
+}
+
+static uint32_t rng_below(uint32_t n)
+{
+  return rng_next() % n;
+}
+
+/* Mostly on screen, sometimes past the edge, now and then wrapped below zero. */
+static uint16_t rng_coord(void)
+{
+  uint32_t k = rng_below(20U);
+  if (k == 0U)
+  {
+    return (uint16_t)(65536U - rng_below(40U));
+  }
+  if (k < 3U)
+  {
+    return (uint16_t)rng_below(400U);
+  }
+  return (uint16_t)rng_below(180U);
+}
+
+static void take_rows(uint16_t max_rows)
+{
+  uint16_t rows[DISPLAY_HEIGHT];
+  uint16_t count = 0U;
+  bool full = false;
+
+  if (renderTakeDirtyRows(rows, max_rows, &count, &full))
+  {
+    const uint8_t *buf = renderGetBuffer();
+    for (uint16_t i = 0U; i < count; ++i)
+    {
+      memcpy(s_glass[rows[i] - 1U], &buf[LCD_STREAM_DATA_OFFSET(rows[i])], LINE_WIDTH);
+    }
+  }
+
+  if (l8RenderTakeDirtyRows(rows, max_rows, &count, &full))
+  {
+    const uint8_t *buf = l8RenderGetBuffer();
+    for (uint16_t i = 0U; i < count; ++i)
+    {
+      memcpy(s_glass_l8[rows[i] - 1U], &buf[(rows[i] - 1U) * LINE_WIDTH], LINE_WIDTH);
+    }
+  }
+}
+
+static bool check_glass(uint32_t call)
+{
+  for (uint32_t i = 0U; i < (DISPLAY_HEIGHT * 2U); ++i)
+  {
+    take_rows(DISPLAY_HEIGHT);
+  }
+
+  for (uint32_t y = 0U; y < DISPLAY_HEIGHT; ++y)
+  {
+    for (uint32_t b = 0U; b < LINE_WIDTH; ++b)
+    {
+      if (s_glass[y][b] != s_glass_l8[y][b])
+      {
+        printf("FAIL after call %u: row %u byte %u is 0x%02X, reference 0x%02X (rotation %u)\n",
+               (unsigned)call, (unsigned)(y + 1U), (unsigned)b, s_glass[y][b], s_glass_l8[y][b],
+               (unsigned)renderGetRotation());
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static void random_text(char *text, uint32_t max_len, bool scaled)
+{
+  uint32_t n = rng_below(max_len);
+  for (uint32_t i = 0U; i < n; ++i)
+  {
+    uint32_t k = rng_below(12U);
+    char ch;
+    if (k == 0U)
+    {
+      ch = '\n';
+    }
+    else if ((k == 1U) && !scaled)
+    {
+      ch = (char)(1U + rng_below(255U));
+    }
+    else
+    {
+      ch = (char)(32U + rng_below(95U));
+    }
+    text[i] = ch;
+  }
+  text[n] = '\0';
+}
+
+/* One random call, made identically on both renderers. */
+static void random_call(void)
+{
+  const render_layer_t layer = (render_layer_t)rng_below(3U);
+  const render_state_t state = (render_state_t)rng_below(3U);
+  const uint16_t x = rng_coord();
+  const uint16_t y = rng_coord();
+
+  switch (rng_below(24U))
+  {
+    case 0:
+      if (rng_below(20U) == 0U)
+      {
+        bool fill = (rng_below(2U) != 0U);
+        renderFill(fill);
+        l8RenderFill(fill);
+      }
+      break;
+    case 1:
+      if (rng_below(30U) == 0U)
+      {
+        renderInvert();
+        l8RenderInvert();
+      }
+      break;
+    case 2:
+    {
+      uint16_t a = (uint16_t)rng_below(180U);
+      uint16_t b = (uint16_t)rng_below(180U);
+      bool fill = (rng_below(2U) != 0U);
+      renderFillRows(a, b, fill);
+      l8RenderFillRows(a, b, fill);
+      break;
+    }
+    case 3:
+    {
+      uint16_t a = (uint16_t)rng_below(180U);
+      uint16_t b = (uint16_t)rng_below(180U);
+      renderInvertRows(a, b);
+      l8RenderInvertRows(a, b);
+      break;
+    }
+    case 4:
+      renderSetPixel(x, y, layer, state);
+      l8RenderSetPixel(x, y, layer, state);
+      break;
+    case 5:
+    {
+      uint16_t len = (uint16_t)rng_below(200U);
+      renderDrawHLine(x, y, len, layer, state);
+      l8RenderDrawHLine(x, y, len, layer, state);
+      break;
+    }
+    case 6:
+    {
+      uint16_t len = (uint16_t)rng_below(200U);
+      renderDrawVLine(x, y, len, layer, state);
+      l8RenderDrawVLine(x, y, len, layer, state);
+      break;
+    }
+    case 7:
+    {
+      uint16_t w = (uint16_t)rng_below(100U);
+      uint16_t h = (uint16_t)rng_below(100U);
+      renderFillRect(x, y, w, h, layer, state);
+      l8RenderFillRect(x, y, w, h, layer, state);
+      break;
+    }
+    case 8:
+    {
+      uint16_t w = (uint16_t)rng_below(100U);
+      uint16_t h = (uint16_t)rng_below(100U);
+      renderDrawRect(x, y, w, h, layer, state);
+      l8RenderDrawRect(x, y, w, h, layer, state);
+      break;
+    }
+    case 9:
+    {
+      uint16_t x1 = (uint16_t)rng_below(180U);
+      uint16_t y1 = (uint16_t)rng_below(180U);
+      renderDrawLine(x, y, x1, y1, layer, state);
+      l8RenderDrawLine(x, y, x1, y1, layer, state);
+      break;
+    }
+    case 10:
+    {
+      uint16_t x0 = (uint16_t)rng_below(180U);
+      uint16_t y0 = (uint16_t)rng_below(180U);
+      uint16_t x1 = (uint16_t)rng_below(180U);
+      uint16_t y1 = (uint16_t)rng_below(180U);
+      uint16_t t = (uint16_t)rng_below(8U);
+      renderDrawLineThick(x0, y0, x1, y1, t, layer, state);
+      l8RenderDrawLineThick(x0, y0, x1, y1, t, layer, state);
+      break;
+    }
+    case 11:
+    case 12:
+    case 13:
+    {
+      uint16_t cx = (uint16_t)rng_below(180U);
+      uint16_t cy = (uint16_t)rng_below(180U);
+      uint16_t r = (uint16_t)rng_below(60U);
+      uint16_t t = (uint16_t)rng_below(10U);
+      uint32_t kind = rng_below(3U);
+      if (kind == 0U)
+      {
+        renderDrawCircle(cx, cy, r, layer, state);
+        l8RenderDrawCircle(cx, cy, r, layer, state);
+      }
+      else if (kind == 1U)
+      {
+        renderDrawCircleThick(cx, cy, r, t, layer, state);
+        l8RenderDrawCircleThick(cx, cy, r, t, layer, state);
+      }
+      else
+      {
+        renderFillCircle(cx, cy, r, layer, state);
+        l8RenderFillCircle(cx, cy, r, layer, state);
+      }
+      break;
+    }
+    case 14:
+    {
+      char ch = (char)rng_below(256U);
+      renderDrawChar(x, y, ch, layer, state);
+      l8RenderDrawChar(x, y, ch, layer, state);
+      break;
+    }
+    case 15:
+    case 16:
+    {
+      char text[40];
+      random_text(text, sizeof(text) - 1U, false);
+      renderDrawText(x, y, text, layer, state);
+      l8RenderDrawText(x, y, text, layer, state);
+      break;
+    }
+    case 17:
+    {
+      char text[20];
+      uint8_t scale = (uint8_t)rng_below(6U);
+      random_text(text, sizeof(text) - 1U, true);
+      renderDrawTextScaled(x, y, text, scale, layer, state);
+      l8RenderDrawTextScaled(x, y, text, scale, layer, state);
+      break;
+    }
+    case 18:
+    {
+      char ch = (char)(32U + rng_below(95U));
+      uint8_t scale = (uint8_t)rng_below(6U);
+      renderDrawCharScaled(x, y, ch, scale, layer, state);
+      l8RenderDrawCharScaled(x, y, ch, scale, layer, state);
+      break;
+    }
+    case 19:
+    case 20:
+    {
+      uint16_t w = (uint16_t)(1U + rng_below(64U));
+      uint16_t h = (uint16_t)(1U + rng_below(40U));
+      uint16_t stride = (rng_below(3U) == 0U) ? 0U : (uint16_t)(((w + 7U) / 8U) + rng_below(2U));
+      if (rng_below(2U) == 0U)
+      {
+        renderBlit1bpp(x, y, w, h, s_bitmap, stride, layer, state);
+        l8RenderBlit1bpp(x, y, w, h, s_bitmap, stride, layer, state);
+      }
+      else
+      {
+        renderBlit1bppMsb(x, y, w, h, s_bitmap, stride, layer, state);
+        l8RenderBlit1bppMsb(x, y, w, h, s_bitmap, stride, layer, state);
+      }
+      break;
+    }
+    case 21:
+      if (rng_below(10U) == 0U)
+      {
+        render_rotation_t rotation = (render_rotation_t)rng_below(4U);
+        renderSetRotation(rotation);
+        l8RenderSetRotation(rotation);
+      }
+      break;
+    case 22:
+      if (rng_below(4U) == 0U)
+      {
+        take_rows((uint16_t)(1U + rng_below(DISPLAY_HEIGHT)));
+      }
+      break;
+    default:
+      if (rng_below(10U) == 0U)
+      {
+        uint16_t a = (uint16_t)rng_below(180U);
+        uint16_t b = (uint16_t)rng_below(180U);
+        renderMarkDirtyRows(a, b);
+        l8RenderMarkDirtyRows(a, b);
+      }
+      break;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  uint32_t calls = TEST_DEFAULT_CALLS;
+  if (argc > 1)
+  {
+    calls = (uint32_t)strtoul(argv[1], NULL, 10);
+  }
+  if (argc > 2)
+  {
+    s_rng = (uint32_t)strtoul(argv[2], NULL, 10);
+    if (s_rng == 0U)
+    {
+      s_rng = TEST_DEFAULT_SEED;
+    }
+  }
+
+  /* Both start from a white panel, as after LCD_Init(). */
+  memset(s_glass, 0xFF, sizeof(s_glass));
+  memset(s_glass_l8, 0xFF, sizeof(s_glass_l8));
+  renderInit();
+  l8RenderInit();
+  for (uint32_t i = 0U; i < sizeof(s_bitmap); ++i)
+  {
+    s_bitmap[i] = (uint8_t)rng_next();
+  }
+
+  for (uint32_t call = 0U; call < calls; ++call)
+  {
+    random_call();
+    if ((((call + 1U) % TEST_CHECK_EVERY) == 0U) && !check_glass(call))
+    {
+      return 1;
+    }
+  }
+  if (!check_glass(calls))
+  {
+    return 1;
+  }
+
+  printf("ok: %u calls match the byte-per-pixel compositor\n", (unsigned)calls);
+  return 0;
+}